@@ -10,6 +10,7 @@
  */
 
 #include <iostream>
+#include <limits>
 
 using std::cin;
 using std::cout;
@@ -28,6 +29,7 @@ bool isInvalidInput();
 int getArrayLengthInput();
 int* getArrayInput(const int);
 int* deepCopyArray(const int[], const int);
+void copyArray(int[], const int[], const int);
 
 // ====== Printing Utilities ======
 void printArray(const int[], const int);
@@ -44,11 +46,11 @@ int main() {
 
     length = getArrayLengthInput();
     arr = getArrayInput(length);
+    // One copy buffer for the whole session; every choice refreshes it from the user's order.
+    arr_copy = deepCopyArray(arr, length);
     cout << endl;
     
     do {
-        arr_copy = deepCopyArray(arr, length);
-
         cout << "1. Bubble Sort" << endl;
         cout << "2. Selection Sort" << endl;
         cout << "3. Insertion Sort" << endl;
@@ -70,18 +72,21 @@ int main() {
 
         switch(user_choice) {
             case 1:
-                bubbleSort(arr, length);
-                printArray(arr, length);
+                copyArray(arr_copy, arr, length);
+                bubbleSort(arr_copy, length);
+                printArray(arr_copy, length);
                 cout << endl;
                 break;
             case 2:
-                selectionSort(arr, length);
-                printArray(arr, length);
+                copyArray(arr_copy, arr, length);
+                selectionSort(arr_copy, length);
+                printArray(arr_copy, length);
                 cout << endl;
                 break;
             case 3:
-                insertionSort(arr, length);
-                printArray(arr, length);
+                copyArray(arr_copy, arr, length);
+                insertionSort(arr_copy, length);
+                printArray(arr_copy, length);
                 cout << endl;
                 break;
             case 4:
@@ -320,11 +325,33 @@ int* deepCopyArray(const int arr[], const int length) {
         return nullptr;
     }
 
-    for (int i = 0; i < length; i++) {
-        arr_copy[i] = arr[i];
+    copyArray(arr_copy, arr, length);
+    return arr_copy;
+}
+
+/**
+ * @brief Copies an array into another array of the same length, reusing its memory instead of allocating a copy.
+ * 
+ * @param dest Pointer to the array that receives the elements.
+ * @param src Pointer to the array to copy.
+ * @param length Number of elements in both arrays.
+ * 
+ * @note @p dest & @p src must be non-null pointers for the copy to occur.
+ * 
+ * @code
+ * int arr[] = {5, 1, 2, 3, 4};
+ * int arr_copy[5];
+ * copyArray(arr_copy, arr, 5); // arr_copy = {5, 1, 2, 3, 4}
+ * @endcode
+ */
+void copyArray(int dest[], const int src[], const int length) {
+    if (!dest || !src) {
+        return;
     }
 
-    return arr_copy;
+    for (int i = 0; i < length; i++) {
+        dest[i] = src[i];
+    }
 }
 
 /**
@@ -0,0 +1,342 @@
+/**
+ * @file array_file.cpp
+ * @brief Binary array files - Packed int32 arrays that are memory-mapped & sorted or searched in place.
+ *
+ * Provides function definitions for the array file functions declared in array_file.h.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <cassert>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "array_file.h"
+#include "io.h"
+#include "search.h"
+#include "sort.h"
+
+// ====== Array Files ======
+bool isArrayFile(const char*);
+int writeArrayFile(const char*, const int[], const int);
+int openArrayFile(const char*, const ArrayFileMode, MappedArray*);
+int loadIntegerArray(const char*, const ArrayFileMode, MappedArray*);
+void closeArrayFile(MappedArray*);
+
+// ====== In-place Operations ======
+bool isArrayFileSorted(const MappedArray*);
+int sortArrayFile(MappedArray*, void (*sort)(int[], const int, bool), const bool);
+int viewArrayFile(const MappedArray*, SortedView*);
+
+static_assert(sizeof(ArrayFileHeader) == 32, "Array file header must stay 32 bytes");
+static_assert(sizeof(int) == 4, "Array files hold packed int32 elements");
+
+
+/**
+ * @brief Checks whether a file starts with the array file magic.
+ *
+ * @param path Path of the file.
+ *
+ * @return True, if @p path is an array file; otherwise, false. "-" (standard input) is never an array file.
+ */
+bool isArrayFile(const char* path) {
+    if (!path || std::strcmp(path, "-") == 0) {
+        return false;
+    }
+
+    FILE* file = std::fopen(path, "rb");
+    if (!file) {
+        return false;
+    }
+
+    char magic[sizeof(ARRAY_FILE_MAGIC)];
+    bool matches = std::fread(magic, 1, sizeof(magic), file) == sizeof(magic) &&
+                   std::memcmp(magic, ARRAY_FILE_MAGIC, sizeof(magic)) == 0;
+
+    std::fclose(file);
+    return matches;
+}
+
+/**
+ * @brief Writes an array as an array file. Sets the header's sorted flag if the array is sorted in ascending order.
+ *
+ * @param path Path of the file to write, or "-" for standard output.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ *
+ * @return 0, if the file was written.
+ * @return -2, if @p path is null, if @p arr is null while @p length is positive or if @p length is negative.
+ * @return -4, if the file could not be written.
+ *
+ * @code
+ * int arr[] = {1, 2, 3, 4, 5};
+ *
+ * writeArrayFile("sorted.bin", arr, 5); // Header has the sorted flag set
+ * @endcode
+ */
+int writeArrayFile(const char* path, const int arr[], const int length) {
+    if (!path || (!arr && length > 0)) {
+        return -2;
+    }
+    if (length < 0) {
+        return -2;
+    }
+
+    ArrayFileHeader header = {};
+    std::memcpy(header.magic, ARRAY_FILE_MAGIC, sizeof(header.magic));
+    header.byte_order = ARRAY_FILE_BYTE_ORDER;
+    header.flags = (length == 0 || isSorted(arr, length) == 1) ? ARRAY_FILE_SORTED : 0;
+    header.length = length;
+
+    FILE* file = std::strcmp(path, "-") == 0 ? stdout : std::fopen(path, "wb");
+    if (!file) {
+        return -4;
+    }
+
+    bool written = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                   std::fwrite(arr, sizeof(int), length, file) == (size_t)length;
+
+    if (file == stdout) {
+        written = std::fflush(file) == 0 && written;
+    }
+    else {
+        written = std::fclose(file) == 0 && written;
+    }
+
+    return written ? 0 : -4;
+}
+
+/**
+ * @brief Maps an array file, so its elements can be sorted or searched in place without copying them.
+ *
+ * @param path Path of the array file.
+ * @param mode ARRAY_FILE_READ, ARRAY_FILE_PRIVATE or ARRAY_FILE_WRITE. See ArrayFileMode.
+ * @param array Pointer to the MappedArray that receives the mapping. Release it with closeArrayFile.
+ *
+ * @return 0, if the file was mapped.
+ * @return -2, if @p path or @p array is null.
+ * @return -4, if the file could not be opened or mapped.
+ * @return -5, if the file is not an array file, was written with the other byte order, holds more than
+ *             INT_MAX elements or is truncated.
+ *
+ * @code
+ * MappedArray array;
+ * SortedView view;
+ *
+ * if (openArrayFile("sorted.bin", ARRAY_FILE_READ, &array) == 0) {
+ *     if (viewArrayFile(&array, &view) == 0) {
+ *         binarySearch(4, view);
+ *     }
+ *     closeArrayFile(&array);
+ * }
+ * @endcode
+ */
+int openArrayFile(const char* path, const ArrayFileMode mode, MappedArray* array) {
+    if (!path || !array) {
+        return -2;
+    }
+
+    int fd = open(path, mode == ARRAY_FILE_WRITE ? O_RDWR : O_RDONLY);
+    if (fd < 0) {
+        return -4;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return -4;
+    }
+    if ((size_t)info.st_size < sizeof(ArrayFileHeader)) {
+        close(fd);
+        return -5;
+    }
+
+    size_t map_bytes = info.st_size;
+    int prot = mode == ARRAY_FILE_READ ? PROT_READ : PROT_READ | PROT_WRITE;
+    int flags = mode == ARRAY_FILE_PRIVATE ? MAP_PRIVATE : MAP_SHARED;
+
+    void* map = mmap(nullptr, map_bytes, prot, flags, fd, 0);
+    // The mapping keeps the file alive.
+    close(fd);
+    if (map == MAP_FAILED) {
+        return -4;
+    }
+
+    ArrayFileHeader* header = (ArrayFileHeader*)map;
+    if (std::memcmp(header->magic, ARRAY_FILE_MAGIC, sizeof(header->magic)) != 0 ||
+        header->byte_order != ARRAY_FILE_BYTE_ORDER || header->length > INT_MAX ||
+        map_bytes != sizeof(ArrayFileHeader) + header->length * sizeof(int)) {
+        munmap(map, map_bytes);
+        return -5;
+    }
+
+    // Sorting & searching touch every page; start reading them in before the first fault.
+    madvise(map, map_bytes, MADV_WILLNEED);
+
+    array->data = (int*)(header + 1);
+    array->length = (int)header->length;
+    array->sorted = (header->flags & ARRAY_FILE_SORTED) != 0;
+    array->header = header;
+    array->map_bytes = map_bytes;
+    array->mode = mode;
+    return 0;
+}
+
+/**
+ * @brief Maps an array file, or reads a text file of whitespace-separated integers into memory.
+ *
+ * Lets the programs accept either format for the same option.
+ *
+ * @param path Path of the file, or "-" for text on standard input.
+ * @param mode How to map an array file. Ignored for text files, which are always writable & never sorted.
+ * @param array Pointer to the MappedArray that receives the integers. Release it with closeArrayFile.
+ *
+ * @return 0, if the integers were loaded.
+ * @return -2, if @p path or @p array is null.
+ * @return -4, if the file could not be read.
+ * @return -5, if the file is neither a valid array file nor a text file of integers.
+ */
+int loadIntegerArray(const char* path, const ArrayFileMode mode, MappedArray* array) {
+    if (!path || !array) {
+        return -2;
+    }
+
+    if (isArrayFile(path)) {
+        return openArrayFile(path, mode, array);
+    }
+
+    int* arr;
+    int length;
+    int status = readIntegerFile(path, &arr, &length);
+    if (status != 0) {
+        return status;
+    }
+
+    array->data = arr;
+    array->length = length;
+    array->sorted = false;
+    array->header = nullptr;
+    array->map_bytes = 0;
+    array->mode = ARRAY_FILE_PRIVATE;
+    return 0;
+}
+
+/**
+ * @brief Unmaps an array file, or frees the integers of a text file.
+ *
+ * With ARRAY_FILE_WRITE, changes reach the file through the page cache; the kernel writes them back to disk.
+ *
+ * @param array Pointer to a MappedArray from openArrayFile or loadIntegerArray. Null does nothing.
+ */
+void closeArrayFile(MappedArray* array) {
+    if (!array) {
+        return;
+    }
+
+    if (array->header) {
+        munmap(array->header, array->map_bytes);
+    }
+    else {
+        delete[] array->data;
+    }
+
+    array->data = nullptr;
+    array->length = 0;
+    array->sorted = false;
+    array->header = nullptr;
+    array->map_bytes = 0;
+}
+
+/**
+ * @brief Checks whether the array is known to be sorted in ascending order, without scanning it.
+ *
+ * @return True, if the header's sorted flag is set or sortArrayFile sorted the array in ascending order; otherwise, false.
+ */
+bool isArrayFileSorted(const MappedArray* array) {
+    return array && array->sorted;
+}
+
+/**
+ * @brief Sorts a mapped array in place & updates the header's sorted flag.
+ *
+ * @param array Pointer to a writable MappedArray.
+ * @param sort Sorting function from sort.h to use. If null, uses introSort. (default=nullptr)
+ *             Builds without NDEBUG assert that it sorted the array.
+ * @param desc If true, sorts in descending order & clears the sorted flag; otherwise, ascending order & sets it. (default=false)
+ *
+ * @return 0, if the array was sorted.
+ * @return -2, if @p array is null or was mapped with ARRAY_FILE_READ.
+ *
+ * @note With ARRAY_FILE_WRITE, the sorted elements & flag are written back to the file.
+ *
+ * @code
+ * MappedArray array;
+ *
+ * openArrayFile("data.bin", ARRAY_FILE_WRITE, &array);
+ * sortArrayFile(&array); // data.bin is now sorted, with the sorted flag set
+ * closeArrayFile(&array);
+ * @endcode
+ */
+int sortArrayFile(MappedArray* array, void (*sort)(int[], const int, bool), const bool desc) {
+    if (!array) {
+        return -2;
+    }
+    if (array->header && array->mode == ARRAY_FILE_READ) {
+        return -2;
+    }
+
+    // Skip the sort, & the page writes it would cause, when the flag already vouches for the order.
+    if (!(array->sorted && !desc) && array->length > 0) {
+        if (sort) {
+            sort(array->data, array->length, desc);
+        } else {
+            introSort(array->data, array->length, desc);
+        }
+        // The flag is persisted & trusted by every later viewArrayFile, so a callback that did not sort must not set it.
+        assert(isSorted(array->data, array->length, desc) == 1);
+    }
+
+    array->sorted = !desc || array->length <= 1;
+    if (array->header) {
+        uint32_t flags = array->sorted ? array->header->flags | ARRAY_FILE_SORTED
+                                       : array->header->flags & ~ARRAY_FILE_SORTED;
+        // Avoid dirtying the header page when the flag is already right.
+        if (flags != array->header->flags) {
+            array->header->flags = flags;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Returns a view of a mapped array whose sorted flag is set, trusting the flag instead of calling isSorted.
+ *
+ * @param array Pointer to the MappedArray.
+ * @param view Pointer to the view that receives the array.
+ *
+ * @return 0, if @p view now refers to the array.
+ * @return -2, if @p array or @p view is null or if the array is empty.
+ * @return -3, if the array is not known to be sorted in ascending order.
+ *
+ * @note The view is valid until the array is closed or modified.
+ */
+int viewArrayFile(const MappedArray* array, SortedView* view) {
+    if (!array || !view) {
+        return -2;
+    }
+    if (!array->data || array->length <= 0) {
+        return -2;
+    }
+    if (!array->sorted) {
+        return -3;
+    }
+
+    *view = SortedView(array->data, array->length);
+    return 0;
+}
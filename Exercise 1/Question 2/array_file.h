@@ -0,0 +1,74 @@
+/**
+ * @file array_file.h
+ * @brief Binary array files - Packed int32 arrays that are memory-mapped & sorted or searched in place.
+ *
+ * Layout: a 32-byte ArrayFileHeader, followed by the elements as packed native int32.
+ * Because the mapping is page-aligned, the elements start on a 32-byte boundary.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "sorted_view.h"
+
+// Identifies an array file: "DSAINT32".
+static const char ARRAY_FILE_MAGIC[8] = {'D', 'S', 'A', 'I', 'N', 'T', '3', '2'};
+// Written in the byte order of the writer; a reader that sees it reversed rejects the file.
+static const uint32_t ARRAY_FILE_BYTE_ORDER = 0x01020304;
+// Header flag: the elements are sorted in ascending order.
+static const uint32_t ARRAY_FILE_SORTED = 1;
+
+/**
+ * @brief First 32 bytes of an array file.
+ */
+struct ArrayFileHeader {
+    char magic[8];
+    uint32_t byte_order;
+    uint32_t flags;
+    uint64_t length;
+    uint64_t reserved;
+};
+
+/**
+ * @brief How an array file is mapped.
+ *
+ * ARRAY_FILE_READ: read-only.
+ * ARRAY_FILE_PRIVATE: writable, but changes stay in memory (copy-on-write, pages are copied only when written).
+ * ARRAY_FILE_WRITE: writable, & changes are written back to the file.
+ */
+enum ArrayFileMode {
+    ARRAY_FILE_READ,
+    ARRAY_FILE_PRIVATE,
+    ARRAY_FILE_WRITE
+};
+
+/**
+ * @brief Integer array backed by a mapped array file, or by a new[] buffer when loaded from a text file.
+ *
+ * header is null for text files. sorted mirrors the header's sorted flag & is kept up to date
+ * by sortArrayFile. Release either kind with closeArrayFile.
+ */
+struct MappedArray {
+    int* data;
+    int length;
+    bool sorted;
+    ArrayFileHeader* header;
+    size_t map_bytes;
+    ArrayFileMode mode;
+};
+
+// ====== Array Files ======
+bool isArrayFile(const char*);
+int writeArrayFile(const char*, const int[], const int);
+int openArrayFile(const char*, const ArrayFileMode, MappedArray*);
+int loadIntegerArray(const char*, const ArrayFileMode, MappedArray*);
+void closeArrayFile(MappedArray*);
+
+// ====== In-place Operations ======
+bool isArrayFileSorted(const MappedArray*);
+int sortArrayFile(MappedArray*, void (*sort)(int[], const int, bool)=nullptr, const bool desc=false);
+int viewArrayFile(const MappedArray*, SortedView*);
@@ -0,0 +1,157 @@
+/**
+ * @file bench_binary_search.cpp
+ * @brief Benchmark of binary search latency as the array outgrows the L1, L2 & L3 caches.
+ *
+ * For every array size from 2^10 up to 2^max_log2 integers, runs the same random
+ * queries through binarySearch on a SortedView, std::lower_bound, branchlessBinarySearch,
+ * eytzingerSearch & staticTreeSearch, and prints the average latency per query in nanoseconds. The last
+ * three columns are the amortized cost per query of binarySearchBatch, with the queries
+ * in their given order & sorted first, & of binarySearchBatchInterleaved. binarySearchBatch
+ * interleaves only arrays larger than an L2 cache; comparing "interleaved" with "branchless"
+ * shows the array size from which interleaving pays off.
+ *
+ * Usage: bench_binary_search [max_log2 (default=24)] [queries (default=1000000)]
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "bench_util.h"
+#include "search.h"
+
+using std::vector;
+
+// ====== Benchmark Utilities ======
+template <typename Search>
+static double timeQueries(const vector<int>&, Search, long long*);
+
+
+int main(int argc, char* argv[]) {
+    int max_log2 = argc > 1 ? std::atoi(argv[1]) : 24;
+    int num_queries = argc > 2 ? std::atoi(argv[2]) : 1000000;
+
+    if (max_log2 < 10 || max_log2 > 30 || num_queries <= 0) {
+        std::fprintf(stderr, "Usage: %s [max_log2 (10-30)] [queries (>0)]\n", argv[0]);
+        return 1;
+    }
+
+    std::printf("%12s %10s %14s %14s %14s %14s %14s %14s %14s %14s\n", "elements", "KiB", "binarySearch", "lower_bound",
+                "branchless", "eytzinger", "static_tree", "batch", "batch_sorted", "interleaved");
+
+    uint64_t seed = 42;
+
+    for (int log2 = 10; log2 <= max_log2; log2++) {
+        int length = 1 << log2;
+
+        // Even keys only, so about half of the uniformly drawn queries miss.
+        vector<int> arr(length);
+        for (int i = 0; i < length; i++) {
+            arr[i] = 2*i;
+        }
+
+        vector<int> queries(num_queries);
+        for (int& q : queries) {
+            q = (int)(nextRandom(&seed) % (2*(uint64_t)length));
+        }
+
+        SortedView view;
+        makeSortedView(arr.data(), length, &view);
+
+        EytzingerIndex index;
+        if (buildEytzingerIndex(arr.data(), length, &index) != 0) {
+            std::fprintf(stderr, "Could not build the Eytzinger index for %d elements.\n", length);
+            return 1;
+        }
+
+        StaticTreeIndex tree;
+        if (buildStaticTreeIndex(view, &tree) != 0) {
+            std::fprintf(stderr, "Could not build the static search tree for %d elements.\n", length);
+            return 1;
+        }
+
+        long long checksums[5] = {0, 0, 0, 0, 0};
+
+        double classic_ns = timeQueries(queries, [&](int q) {
+            return binarySearch(q, view);
+        }, &checksums[3]);
+        double lower_bound_ns = timeQueries(queries, [&](int q) {
+            auto it = std::lower_bound(arr.begin(), arr.end(), q);
+            return (it != arr.end() && *it == q) ? (int)(it - arr.begin()) : -1;
+        }, &checksums[0]);
+        double branchless_ns = timeQueries(queries, [&](int q) {
+            return branchlessBinarySearch(q, arr.data(), length);
+        }, &checksums[1]);
+        double eytzinger_ns = timeQueries(queries, [&](int q) {
+            return eytzingerSearch(q, &index);
+        }, &checksums[2]);
+
+        double static_tree_ns = timeQueries(queries, [&](int q) {
+            return staticTreeSearch(q, &tree);
+        }, &checksums[4]);
+
+        freeEytzingerIndex(&index);
+        freeStaticTreeIndex(&tree);
+
+        vector<int> batch_out(num_queries);
+        double batch_ns[3];
+
+        // Runs 0 & 1: binarySearchBatch with the queries as given & sorted; run 2: always interleaved.
+        for (int run = 0; run < 3; run++) {
+            double start = nowNs();
+            if (run < 2) {
+                binarySearchBatch(queries.data(), num_queries, view, batch_out.data(), run == 1);
+            } else {
+                binarySearchBatchInterleaved(queries.data(), num_queries, view, batch_out.data());
+            }
+            batch_ns[run] = (nowNs() - start) / num_queries;
+
+            long long sum = 0;
+            for (int idx : batch_out) {
+                sum += idx;
+            }
+            if (sum != checksums[3]) {
+                std::fprintf(stderr, "Batched search results differ at %d elements.\n", length);
+                return 1;
+            }
+        }
+
+        // Keys are unique, so every search must find the same index.
+        if (checksums[0] != checksums[1] || checksums[0] != checksums[2] || checksums[0] != checksums[3]
+            || checksums[0] != checksums[4]) {
+            std::fprintf(stderr, "Search results differ at %d elements.\n", length);
+            return 1;
+        }
+
+        std::printf("%12d %10zu %11.1f ns %11.1f ns %11.1f ns %11.1f ns %11.1f ns %11.1f ns %11.1f ns %11.1f ns\n",
+                    length, length*sizeof(int) / 1024, classic_ns, lower_bound_ns, branchless_ns, eytzinger_ns,
+                    static_tree_ns, batch_ns[0], batch_ns[1], batch_ns[2]);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Returns the average time per query of @p search in nanoseconds.
+ *
+ * @param queries Values to search for.
+ * @param search Callable that returns the index found for a query, or -1.
+ * @param checksum Receives the sum of the returned indices, so results can be compared & are not optimized away.
+ */
+template <typename Search>
+static double timeQueries(const vector<int>& queries, Search search, long long* checksum) {
+    long long sum = 0;
+
+    double start = nowNs();
+    for (int q : queries) {
+        sum += search(q);
+    }
+    double elapsed = nowNs() - start;
+
+    *checksum = sum;
+    return elapsed / queries.size();
+}
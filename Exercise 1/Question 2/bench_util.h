@@ -0,0 +1,33 @@
+/**
+ * @file bench_util.h
+ * @brief Helpers shared by the benchmark programs - Random numbers, Timing.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+/**
+ * @brief Returns the next number of a xorshift64 sequence.
+ *
+ * @param state Pointer to the non-zero generator state, which is advanced.
+ */
+static inline uint64_t nextRandom(uint64_t* state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+/**
+ * @brief Returns a monotonic timestamp in nanoseconds.
+ */
+static inline double nowNs() {
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
@@ -0,0 +1,565 @@
+/**
+ * @file benchmark.cpp
+ * @brief Benchmark suite for every sorting & searching routine.
+ *
+ * Runs each routine over a sweep of array sizes (powers of ten) & input distributions
+ * and reports the time per element. Sorts that are generic templates are run a second
+ * time on an instrumented element type to count comparisons, swaps & moves. Searches
+ * report the time per query as their time per element &, in builds with -DDSA_INSTRUMENT,
+ * the comparisons per query counted by their countComparisons hooks.
+ *
+ * interpolationSearch & exponentialSearch run on the same sorted copies as binarySearch;
+ * "random" & "sorted" give them evenly spread keys & "skewed" log-uniform ones.
+ *
+ * buildHashIndex & hashSearch are the hash path to point lookups; the sort+search path
+ * they replace is introSort (what sortToView runs) or radixSort, then binarySearch.
+ *
+ * nthElement selects the median. "adversarial" is McIlroy's antiqsort input against it,
+ * which makes every median-of-three pivot nearly the smallest element; the benchmark fails
+ * if nthElement takes more than NTH_ELEMENT_MAX_COMPARISONS per element on any input.
+ *
+ * Usage: benchmark [--min=100] [--max=10000000] [--max-quadratic=10000] [--filter=name]
+ *                  [--format=table|csv|json] [--output=file]
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "bench_util.h"
+#include "search.h"
+#include "sort.h"
+#include "sort_stats.h"
+
+using std::string;
+using std::vector;
+
+/**
+ * @brief Sorting routine under test: the int function & an optional instrumented twin.
+ */
+struct SortRoutine {
+    const char* name;
+    void (*sort)(int[], const int, bool);
+    void (*count)(CountedInt*, CountedInt*);
+    bool quadratic;
+};
+
+/**
+ * @brief Options parsed from the command line.
+ */
+struct BenchOptions {
+    long long min_length = 100;
+    long long max_length = 10000000;
+    long long max_quadratic = 10000;
+    string filter;
+    string format = "table";
+    string output;
+};
+
+/**
+ * @brief One row of the report. Counts are -1 where they are not measured.
+ */
+struct BenchResult {
+    string routine;
+    string distribution;
+    int length;
+    int repetitions;
+    double ns_per_element;
+    long long comparisons;
+    long long swaps;
+    long long moves;
+};
+
+// ====== Input Generators ======
+static vector<int> makeInput(const string&, const int, uint64_t*);
+static vector<int> makeSelectionKiller(const int);
+
+// ====== Runners ======
+static BenchResult runSort(const SortRoutine&, const string&, const vector<int>&);
+static BenchResult runLinearSearch(const string&, const vector<int>&, uint64_t*);
+static BenchResult runSortedSearch(const char*, int (*)(const int, const SortedView&), const string&,
+                                   const vector<int>&, uint64_t*);
+static BenchResult runHashBuild(const string&, const vector<int>&);
+static BenchResult runHashSearch(const string&, const vector<int>&, uint64_t*);
+static BenchResult runNthElement(const string&, const vector<int>&);
+static long long comparisonsPerQuery(const int);
+
+// ====== Reporting ======
+static void writeReport(FILE*, const string&, const vector<BenchResult>&);
+
+// ====== Option Parsing ======
+static bool parseOptions(int, char*[], BenchOptions*);
+
+static const char* DISTRIBUTIONS[] = {"random", "sorted", "reverse", "few-unique", "organ-pipe", "nearly-sorted", "skewed",
+                                      "adversarial"};
+
+static const SortRoutine SORT_ROUTINES[] = {
+    {"bubbleSort", bubbleSort, [](CountedInt* f, CountedInt* l) { bubbleSort(f, l); }, true},
+    {"selectionSort", selectionSort, [](CountedInt* f, CountedInt* l) { selectionSort(f, l); }, true},
+    {"insertionSort", insertionSort, [](CountedInt* f, CountedInt* l) { insertionSort(f, l); }, true},
+    {"heapSort", heapSort, [](CountedInt* f, CountedInt* l) { heapSort(f, l); }, false},
+    {"introSort", introSort, [](CountedInt* f, CountedInt* l) { introSort(f, l); }, false},
+    {"adaptiveSort", adaptiveSort, [](CountedInt* f, CountedInt* l) { adaptiveSort(f, l); }, false},
+    {"stableSort", [](int a[], const int n, bool d) { stableSort(a, n, d); }, [](CountedInt* f, CountedInt* l) { stableSort(f, l); }, false},
+    {"radixSort", [](int a[], const int n, bool d) { radixSort(a, n, d); }, nullptr, false},
+    {"parallelMergeSort", [](int a[], const int n, bool d) { parallelMergeSort(a, n, d); }, nullptr, false},
+};
+
+// Each measurement repeats until it has taken at least this long.
+static const double MIN_MEASURE_NS = 1e8;
+
+// Comparisons per element above which nthElement is no longer O(n). It takes about 3 on random input & 14 on "adversarial".
+static const double NTH_ELEMENT_MAX_COMPARISONS = 20;
+
+// Search results are stored here so that the compiler cannot drop the searches.
+static volatile long long benchmark_sink;
+
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+
+    if (!parseOptions(argc, argv, &options)) {
+        std::fprintf(stderr, "Usage: %s [--min=100] [--max=10000000] [--max-quadratic=10000] [--filter=name]\n"
+                             "       [--format=table|csv|json] [--output=file]\n", argv[0]);
+        return 1;
+    }
+
+    vector<BenchResult> results;
+    uint64_t seed = 42;
+
+    for (long long length = options.min_length; length <= options.max_length; length *= 10) {
+        for (const char* distribution : DISTRIBUTIONS) {
+            vector<int> input = makeInput(distribution, (int)length, &seed);
+
+            for (const SortRoutine& routine : SORT_ROUTINES) {
+                if (routine.quadratic && length > options.max_quadratic) {
+                    continue;
+                }
+                if (!options.filter.empty() && options.filter != routine.name) {
+                    continue;
+                }
+                results.push_back(runSort(routine, distribution, input));
+                std::fprintf(stderr, "%s/%s/%lld done\n", routine.name, distribution, length);
+            }
+
+            if (options.filter.empty() || options.filter == "nthElement") {
+                results.push_back(runNthElement(distribution, input));
+            }
+            if (options.filter.empty() || options.filter == "linearSearch") {
+                results.push_back(runLinearSearch(distribution, input, &seed));
+            }
+            if (options.filter.empty() || options.filter == "binarySearch") {
+                results.push_back(runSortedSearch("binarySearch", binarySearch, distribution, input, &seed));
+            }
+            if (options.filter.empty() || options.filter == "interpolationSearch") {
+                results.push_back(runSortedSearch("interpolationSearch", interpolationSearch, distribution, input, &seed));
+            }
+            if (options.filter.empty() || options.filter == "exponentialSearch") {
+                results.push_back(runSortedSearch("exponentialSearch", exponentialSearch, distribution, input, &seed));
+            }
+            if (options.filter.empty() || options.filter == "buildHashIndex") {
+                results.push_back(runHashBuild(distribution, input));
+            }
+            if (options.filter.empty() || options.filter == "hashSearch") {
+                results.push_back(runHashSearch(distribution, input, &seed));
+            }
+        }
+    }
+
+    FILE* out = stdout;
+    if (!options.output.empty()) {
+        out = std::fopen(options.output.c_str(), "w");
+        if (!out) {
+            std::fprintf(stderr, "Error: Could not open %s for writing.\n", options.output.c_str());
+            return 1;
+        }
+    }
+
+    writeReport(out, options.format, results);
+
+    if (out != stdout) {
+        std::fclose(out);
+    }
+    return 0;
+}
+
+/**
+ * @brief Returns an array of @p length integers with the given distribution.
+ *
+ * @param distribution One of DISTRIBUTIONS.
+ * @param length Number of elements.
+ * @param seed Pointer to the random generator state.
+ */
+static vector<int> makeInput(const string& distribution, const int length, uint64_t* seed) {
+    vector<int> arr(length);
+
+    if (distribution == "random") {
+        for (int& x : arr) x = (int)nextRandom(seed);
+    }
+    else if (distribution == "sorted") {
+        for (int i = 0; i < length; i++) arr[i] = i;
+    }
+    else if (distribution == "reverse") {
+        for (int i = 0; i < length; i++) arr[i] = length - i;
+    }
+    else if (distribution == "few-unique") {
+        for (int& x : arr) x = (int)(nextRandom(seed) % 16);
+    }
+    else if (distribution == "organ-pipe") {
+        for (int i = 0; i < length; i++) arr[i] = i < length/2 ? i : length - i;
+    }
+    else if (distribution == "nearly-sorted") {
+        // Sorted, then 1% of the positions swapped with a random partner.
+        for (int i = 0; i < length; i++) arr[i] = i;
+        for (int k = 0; k < length/100; k++) {
+            std::swap(arr[nextRandom(seed) % length], arr[nextRandom(seed) % length]);
+        }
+    }
+    else if (distribution == "skewed") {
+        // Log-uniform between 1 & 2^31: as many values below 1000 as between 1000 & 10^6.
+        for (int& x : arr) x = (int)std::exp((double)(nextRandom(seed) >> 11) / (1ULL << 53) * std::log(2147483647.0));
+    }
+    else if (distribution == "adversarial") {
+        arr = makeSelectionKiller(length);
+    }
+
+    return arr;
+}
+
+/**
+ * @brief Comparison of McIlroy's antiqsort adversary: it assigns the values of a sort's input as the sort compares them.
+ *
+ * Every element starts as "gas", larger than any value assigned so far. When two gas elements
+ * are compared, one is frozen to the next smallest value, preferring the one the algorithm
+ * compared last (likely its pivot), so each pivot turns out to be nearly the minimum.
+ */
+struct AntiQuicksortCompare {
+    vector<int>* values;
+    int* frozen;
+    int* candidate;
+    int gas;
+
+    bool operator()(const int x, const int y) const {
+        vector<int>& v = *values;
+
+        if (v[x] == gas && v[y] == gas) {
+            v[x == *candidate ? x : y] = (*frozen)++;
+        }
+        if (v[x] == gas) {
+            *candidate = x;
+        } else if (v[y] == gas) {
+            *candidate = y;
+        }
+        return v[x] < v[y];
+    }
+};
+
+/**
+ * @brief Returns the input on which nthElement's quickselect does the most work when it selects the median.
+ *
+ * Runs nthElement on the positions 0..length-1 under the adversary; as it is deterministic,
+ * the values the adversary assigned make it take the same steps when selecting from them.
+ */
+static vector<int> makeSelectionKiller(const int length) {
+    vector<int> values(length, length);
+    vector<int> positions(length);
+    int frozen = 0;
+    int candidate = 0;
+
+    for (int i = 0; i < length; i++) positions[i] = i;
+
+    nthElement(positions.begin(), positions.begin() + length/2, positions.end(),
+               AntiQuicksortCompare{&values, &frozen, &candidate, length});
+
+    return values;
+}
+
+/**
+ * @brief Times a sort on copies of @p input & counts its operations on the instrumented twin.
+ */
+static BenchResult runSort(const SortRoutine& routine, const string& distribution, const vector<int>& input) {
+    const int length = (int)input.size();
+    vector<int> work(length);
+
+    double total_ns = 0;
+    int repetitions = 0;
+
+    // Only the sort is timed; refreshing the copy happens outside the clock.
+    while (total_ns < MIN_MEASURE_NS || repetitions < 1) {
+        std::copy(input.begin(), input.end(), work.begin());
+
+        double start = nowNs();
+        routine.sort(work.data(), length, false);
+        total_ns += nowNs() - start;
+        repetitions++;
+    }
+
+    if (!std::is_sorted(work.begin(), work.end())) {
+        std::fprintf(stderr, "Error: %s did not sort the %s input of %d elements.\n", routine.name,
+                     distribution.c_str(), length);
+        std::exit(1);
+    }
+
+    BenchResult result = {routine.name, distribution, length, repetitions,
+                          total_ns / repetitions / length, -1, -1, -1};
+
+    if (routine.count) {
+        vector<CountedInt> counted(input.begin(), input.end());
+        CountedInt::comparisons = CountedInt::swaps = CountedInt::moves = 0;
+
+        routine.count(counted.data(), counted.data() + length);
+
+        result.comparisons = CountedInt::comparisons;
+        result.swaps = CountedInt::swaps;
+        result.moves = CountedInt::moves;
+    }
+
+    return result;
+}
+
+/**
+ * @brief Times nthElement selecting the median of copies of @p input & checks that it stays O(n) in comparisons.
+ */
+static BenchResult runNthElement(const string& distribution, const vector<int>& input) {
+    const int length = (int)input.size();
+    const int k = length / 2;
+    vector<int> work(length);
+
+    double total_ns = 0;
+    int repetitions = 0;
+
+    while (total_ns < MIN_MEASURE_NS || repetitions < 1) {
+        std::copy(input.begin(), input.end(), work.begin());
+
+        double start = nowNs();
+        nthElement(work.data(), length, k);
+        total_ns += nowNs() - start;
+        repetitions++;
+    }
+
+    if (std::any_of(work.begin(), work.begin() + k, [&](int x) { return x > work[k]; }) ||
+        std::any_of(work.begin() + k, work.end(), [&](int x) { return x < work[k]; })) {
+        std::fprintf(stderr, "Error: nthElement did not select the median of the %s input of %d elements.\n",
+                     distribution.c_str(), length);
+        std::exit(1);
+    }
+
+    vector<CountedInt> counted(input.begin(), input.end());
+    CountedInt::comparisons = CountedInt::swaps = CountedInt::moves = 0;
+
+    nthElement(counted.begin(), counted.begin() + k, counted.end());
+
+    if (CountedInt::comparisons > NTH_ELEMENT_MAX_COMPARISONS * length) {
+        std::fprintf(stderr, "Error: nthElement took %.1f comparisons per element on the %s input of %d elements.\n",
+                     (double)CountedInt::comparisons / length, distribution.c_str(), length);
+        std::exit(1);
+    }
+
+    return {"nthElement", distribution, length, repetitions, total_ns / repetitions / length,
+            CountedInt::comparisons, CountedInt::swaps, CountedInt::moves};
+}
+
+/**
+ * @brief Returns queries that hit @p arr about half of the time.
+ */
+static vector<int> makeQueries(const vector<int>& arr, const int num_queries, uint64_t* seed) {
+    vector<int> queries(num_queries);
+
+    for (int& q : queries) {
+        uint64_t r = nextRandom(seed);
+        q = (r & 1) ? arr[(r >> 1) % arr.size()] : (int)(r >> 1);
+    }
+
+    return queries;
+}
+
+/**
+ * @brief Times linearSearch on @p input; the time per element is the time per query.
+ */
+static BenchResult runLinearSearch(const string& distribution, const vector<int>& input, uint64_t* seed) {
+    const int length = (int)input.size();
+    // Each query scans up to the whole array, so fewer queries are needed as the array grows.
+    const int num_queries = (int)std::max(16LL, std::min(100000LL, 100000000LL / length));
+    vector<int> queries = makeQueries(input, num_queries, seed);
+
+    long long checksum = 0;
+    CountedInt::comparisons = 0;
+    double start = nowNs();
+    for (int q : queries) {
+        checksum += linearSearch(q, input.data(), length);
+    }
+    double elapsed = nowNs() - start;
+
+    benchmark_sink = checksum;
+
+    return {"linearSearch", distribution, length, num_queries, elapsed / num_queries,
+            comparisonsPerQuery(num_queries), -1, -1};
+}
+
+/**
+ * @brief Times a search of a sorted copy of @p input; the time per element is the time per query.
+ *
+ * @param name Name of the routine in the report.
+ * @param search binarySearch, interpolationSearch or exponentialSearch.
+ */
+static BenchResult runSortedSearch(const char* name, int (*search)(const int, const SortedView&),
+                                   const string& distribution, const vector<int>& input, uint64_t* seed) {
+    const int length = (int)input.size();
+    const int num_queries = 1000000;
+    vector<int> sorted(input);
+    SortedView view = sortToView(sorted.data(), length);
+    vector<int> queries = makeQueries(sorted, num_queries, seed);
+
+    long long checksum = 0;
+    CountedInt::comparisons = 0;
+    double start = nowNs();
+    for (int q : queries) {
+        checksum += search(q, view);
+    }
+    double elapsed = nowNs() - start;
+
+    benchmark_sink = checksum;
+
+    return {name, distribution, length, num_queries, elapsed / num_queries, comparisonsPerQuery(num_queries), -1, -1};
+}
+
+/**
+ * @brief Times buildHashIndex on @p input, the hash path's counterpart of sorting it.
+ */
+static BenchResult runHashBuild(const string& distribution, const vector<int>& input) {
+    const int length = (int)input.size();
+    HashIndex index;
+
+    double total_ns = 0;
+    int repetitions = 0;
+
+    while (total_ns < MIN_MEASURE_NS || repetitions < 1) {
+        double start = nowNs();
+        int status = buildHashIndex(input.data(), length, &index);
+        total_ns += nowNs() - start;
+        repetitions++;
+
+        if (status != 0) {
+            std::fprintf(stderr, "Error: Could not build the hash index of %d elements.\n", length);
+            std::exit(1);
+        }
+        freeHashIndex(&index);
+    }
+
+    return {"buildHashIndex", distribution, length, repetitions, total_ns / repetitions / length, -1, -1, -1};
+}
+
+/**
+ * @brief Times hashSearch on an index of @p input; the time per element is the time per query.
+ */
+static BenchResult runHashSearch(const string& distribution, const vector<int>& input, uint64_t* seed) {
+    const int length = (int)input.size();
+    const int num_queries = 1000000;
+    vector<int> queries = makeQueries(input, num_queries, seed);
+    HashIndex index;
+
+    if (buildHashIndex(input.data(), length, &index) != 0) {
+        std::fprintf(stderr, "Error: Could not build the hash index of %d elements.\n", length);
+        std::exit(1);
+    }
+
+    long long checksum = 0;
+    CountedInt::comparisons = 0;
+    double start = nowNs();
+    for (int q : queries) {
+        checksum += hashSearch(q, &index);
+    }
+    double elapsed = nowNs() - start;
+
+    benchmark_sink = checksum;
+    freeHashIndex(&index);
+
+    return {"hashSearch", distribution, length, num_queries, elapsed / num_queries, comparisonsPerQuery(num_queries), -1, -1};
+}
+
+/**
+ * @brief Returns the comparisons counted since CountedInt::comparisons was reset, per query & rounded.
+ *
+ * @return -1 without DSA_INSTRUMENT, where the searches' countComparisons hooks compile to nothing.
+ */
+static long long comparisonsPerQuery([[maybe_unused]] const int num_queries) {
+#ifdef DSA_INSTRUMENT
+    return (CountedInt::comparisons + num_queries/2) / num_queries;
+#else
+    return -1;
+#endif
+}
+
+/**
+ * @brief Writes the results as an aligned table, CSV or a JSON array.
+ *
+ * @param out Stream to write to.
+ * @param format One of "table", "csv" or "json".
+ * @param results Rows to write.
+ */
+static void writeReport(FILE* out, const string& format, const vector<BenchResult>& results) {
+    if (format == "csv") {
+        std::fprintf(out, "routine,distribution,length,repetitions,ns_per_element,comparisons,swaps,moves\n");
+        for (const BenchResult& r : results) {
+            std::fprintf(out, "%s,%s,%d,%d,%.4f,%lld,%lld,%lld\n", r.routine.c_str(), r.distribution.c_str(),
+                         r.length, r.repetitions, r.ns_per_element, r.comparisons, r.swaps, r.moves);
+        }
+    }
+    else if (format == "json") {
+        std::fprintf(out, "[\n");
+        for (size_t i = 0; i < results.size(); i++) {
+            const BenchResult& r = results[i];
+            std::fprintf(out, "  {\"routine\": \"%s\", \"distribution\": \"%s\", \"length\": %d, \"repetitions\": %d, "
+                              "\"ns_per_element\": %.4f, \"comparisons\": %lld, \"swaps\": %lld, \"moves\": %lld}%s\n",
+                         r.routine.c_str(), r.distribution.c_str(), r.length, r.repetitions, r.ns_per_element,
+                         r.comparisons, r.swaps, r.moves, i+1 < results.size() ? "," : "");
+        }
+        std::fprintf(out, "]\n");
+    }
+    else {
+        std::fprintf(out, "%-20s %-14s %10s %14s %16s %16s %16s\n", "routine", "distribution", "length",
+                     "ns/element", "comparisons", "swaps", "moves");
+        for (const BenchResult& r : results) {
+            std::fprintf(out, "%-20s %-14s %10d %14.3f %16lld %16lld %16lld\n", r.routine.c_str(),
+                         r.distribution.c_str(), r.length, r.ns_per_element, r.comparisons, r.swaps, r.moves);
+        }
+    }
+}
+
+/**
+ * @brief Parses --key=value arguments into @p options.
+ *
+ * @return True, if every argument was recognized & valid; otherwise, false.
+ */
+static bool parseOptions(int argc, char* argv[], BenchOptions* options) {
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        size_t eq = arg.find('=');
+
+        if (arg.rfind("--", 0) != 0 || eq == string::npos) {
+            return false;
+        }
+
+        string key = arg.substr(2, eq - 2);
+        string value = arg.substr(eq + 1);
+
+        if (key == "min") options->min_length = std::atoll(value.c_str());
+        else if (key == "max") options->max_length = std::atoll(value.c_str());
+        else if (key == "max-quadratic") options->max_quadratic = std::atoll(value.c_str());
+        else if (key == "filter") options->filter = value;
+        else if (key == "format") options->format = value;
+        else if (key == "output") options->output = value;
+        else return false;
+    }
+
+    if (options->min_length < 1 || options->max_length > 2000000000LL || options->min_length > options->max_length) {
+        return false;
+    }
+
+    return options->format == "table" || options->format == "csv" || options->format == "json";
+}
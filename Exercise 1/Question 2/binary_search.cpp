@@ -0,0 +1,1237 @@
+/**
+ * @file binary_search.cpp
+ * @brief Binary Search algorithms - Classic, Branchless, Range queries, Interpolation, Exponential, Eytzinger layout.
+ * 
+ * Provides function definitions for the binary searches declared in search.h.
+ * 
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include "scratch_arena.h"
+#include "search.h"
+#include "simd.h"
+#include "sort_stats.h"
+#include "sort_templates.h"
+#include "span_api.h"
+
+// ====== Utilities ======
+int isSorted(const int[], const int, const bool);
+
+// ====== Searching Functions ======
+int binarySearch(const int, const int[], const int);
+int binarySearch(const int, const SortedView&);
+int binarySearchBatch(const int[], const int, const int[], const int, int[], const bool);
+int binarySearchBatch(const int[], const int, const SortedView&, int[], const bool);
+int binarySearchBatchInterleaved(const int[], const int, const SortedView&, int[], const bool);
+int branchlessLowerBound(const int, const int[], const int);
+int branchlessBinarySearch(const int, const int[], const int);
+
+// ====== Range Queries ======
+int lowerBound(const int, const int[], const int);
+int lowerBound(const int, const SortedView&);
+int upperBound(const int, const int[], const int);
+int upperBound(const int, const SortedView&);
+int equalRange(const int, const int[], const int, int*, int*);
+int equalRange(const int, const SortedView&, int*, int*);
+int countInRange(const int, const int, const int[], const int);
+int countInRange(const int, const int, const SortedView&);
+
+// ====== Interpolation & Exponential Search ======
+int interpolationSearch(const int, const int[], const int);
+int interpolationSearch(const int, const SortedView&);
+int exponentialSearch(const int, const int[], const int);
+int exponentialSearch(const int, const SortedView&);
+
+// ====== Eytzinger Layout ======
+int buildEytzingerIndex(const int[], const int, EytzingerIndex*);
+void freeEytzingerIndex(EytzingerIndex*);
+int eytzingerSearch(const int, const EytzingerIndex*);
+
+namespace dsa {
+// ====== 64-bit Utilities ======
+bool isSorted(std::span<const int>, bool desc);
+
+// ====== 64-bit Searching Functions ======
+std::optional<size_t> binarySearch(const int, std::span<const int>);
+size_t branchlessLowerBound(const int, std::span<const int>);
+
+// ====== 64-bit Range Queries ======
+size_t lowerBound(const int, std::span<const int>);
+size_t upperBound(const int, std::span<const int>);
+std::pair<size_t, size_t> equalRange(const int, std::span<const int>);
+size_t countInRange(const int, const int, std::span<const int>);
+
+// ====== 64-bit Interpolation & Exponential Search ======
+std::optional<size_t> interpolationSearch(const int, std::span<const int>);
+std::optional<size_t> exponentialSearch(const int, std::span<const int>);
+}
+
+// Size of a cache line; an Eytzinger node's 16 great-great-grandchildren share one line.
+static const size_t CACHE_LINE_BYTES = 64;
+// Number of searches binarySearchBatch keeps in flight at once.
+static const int BATCH_LANES = 16;
+// binarySearchBatch interleaves only arrays longer than this (2 MiB, an L2 cache); shorter ones are searched query by query.
+static const int BATCH_INTERLEAVE_MIN_LENGTH = (2 << 20) / sizeof(int);
+// Bound searches stop halving at this many elements (one cache line of ints) & count them with one SIMD scan.
+static const size_t BOUND_SIMD_SPAN = 16;
+// An interpolation step must cut at least 1/this of the range, or the keys are too skewed to keep interpolating.
+static const size_t INTERPOLATION_MIN_CUT = 4;
+
+
+/**
+ * @brief Checks whether the array is sorted or not.
+ * 
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param desc If true, checks whether the array is sorted in descending order; otherwise, ascending order.
+ * 
+ * @return 1, if the array is sorted; otherwise, 0.
+ * @return -2, if @p arr is null or if @p length is a non-negative integer.
+ * 
+ * @code
+ * int arr[] = {5, 1, 2, 3, 4};
+ * int sorted_arr[] = {1, 2, 3, 4, 5};
+ * 
+ * isSorted(arr, 5); // Returns 0
+ * isSorted(sorted_arr, 5); // Returns 1
+ * isSorted(sorted_arr, 5, true); // Returns 0
+ * @endcode
+ */
+int isSorted(const int arr[], const int length, const bool desc) {
+    if (arr == NULL) {
+        return -2;
+    }
+    if (length <= 0) {
+        return -2;
+    }
+
+    return dsa::isSorted(std::span<const int>(arr, length), desc) ? 1 : 0;
+}
+
+/**
+ * @brief Checks whether the array is sorted or not.
+ * 
+ * @param arr Array to check.
+ * @param desc If true, checks whether the array is sorted in descending order; otherwise, ascending order. (default=false)
+ * 
+ * @return True, if the array is sorted; otherwise, false. An empty array is sorted.
+ */
+bool dsa::isSorted(std::span<const int> arr, const bool desc) {
+    for (size_t i = 1; i < arr.size(); i++) {
+        if (desc ? arr[i] > arr[i-1] : arr[i] < arr[i-1]) return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Returns the index of the first element not less than (if UPPER, greater than) @p value in a sorted array.
+ * 
+ * Halves the range with a conditional move instead of a jump, prefetching both possible
+ * next midpoints, until at most BOUND_SIMD_SPAN elements are left. Those share a cache
+ * line or two, so instead of four more dependent steps they are compared with @p value
+ * all at once: the bound is the base of the span plus the number of its elements below it.
+ * 
+ * @param value Number to be searched in the array.
+ * @param arr, length Array sorted in ascending order & its length, which may be 0.
+ * 
+ * @return Index of the bound; @p length, if every element is below it.
+ */
+template <bool UPPER>
+static size_t branchlessBound(const int value, const int arr[], size_t length) {
+    const int* base = arr;
+
+    while (length > BOUND_SIMD_SPAN) {
+        size_t half = length / 2;
+
+        __builtin_prefetch(base + half/2);
+        __builtin_prefetch(base + half + half/2);
+
+        bool below = UPPER ? base[half-1] <= value : base[half-1] < value;
+        base = below ? base + half : base;
+        length -= half;
+        countComparisons(1);
+    }
+
+    countComparisons(length);
+    int below = UPPER ? simdCountLessEqual(value, base, (int)length) : simdCountLess(value, base, (int)length);
+
+    return (size_t)(base - arr) + below;
+}
+
+/**
+ * @brief Finds the first occurrence of @p value in a sorted array with the branchless lower bound.
+ * 
+ * @return Index of the first occurrence of @p value, if found; otherwise, -1.
+ */
+static int binarySearchSorted(const int value, const int arr[], const int length) {
+    if (value > arr[length-1] || value < arr[0]) {
+        return -1;
+    }
+
+    size_t idx = branchlessBound<false>(value, arr, length);
+
+    return arr[idx] == value ? (int)idx : -1;
+}
+
+/**
+ * @brief Returns the index of the first occurrence of an element in the array using binary search algorithm.
+ * 
+ * @param value Number to be searched in the array.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * 
+ * @return Index of @p value in the array, if found; otherwise, -1.
+ * @return -2, if @p arr is null or if @p length is a non-negative integer.
+ * @return -3, if @p arr is not sorted in ascending order. Only checked in debug builds (NDEBUG undefined).
+ * 
+ * @note The sortedness check is O(n). Release builds skip it, so @p arr must be sorted;
+ * to search repeatedly with the guarantee kept, search a SortedView instead.
+ * 
+ * @code
+ * int arr[] = {5, 1, 2, 3, 4};
+ * int sorted_arr[] = {1, 2, 3, 4, 5};
+ * 
+ * binarySearch(3, arr, 5); // Returns -3 (debug builds)
+ * binarySearch(2, sorted_arr, 5); // Returns 1
+ * binarySearch(6, sorted_arr, 5); // Returns -1
+ * 
+ * int dup_arr[] = {1, 2, 2, 2, 5};
+ * binarySearch(2, dup_arr, 5); // Returns 1, never 2 or 3
+ * @endcode
+ */
+int binarySearch(const int value, const int arr[], const int length) {
+    if (arr == NULL) {
+        return -2;
+    }
+    if (length <= 0) {
+        return -2;
+    }
+#ifndef NDEBUG
+    if (!isSorted(arr, length)) {
+        return -3;
+    }
+#endif
+
+    return binarySearchSorted(value, arr, length);
+}
+
+/**
+ * @brief Returns the index of the first occurrence of an element in a sorted view using binary search algorithm.
+ * 
+ * The view guarantees the array is sorted, so this runs in O(log n) with no sortedness scan.
+ * 
+ * @param value Number to be searched in the array.
+ * @param view View created by makeSortedView or sortToView.
+ * 
+ * @return Index of @p value in the array, if found; otherwise, -1.
+ * @return -2, if @p view is empty.
+ * 
+ * @code
+ * int arr[] = {5, 1, 2, 3, 4};
+ * SortedView view = sortToView(arr, 5);
+ * 
+ * binarySearch(2, view); // Returns 1
+ * binarySearch(6, view); // Returns -1
+ * @endcode
+ */
+int binarySearch(const int value, const SortedView& view) {
+    if (view.empty()) {
+        return -2;
+    }
+
+    return binarySearchSorted(value, view.data(), view.length());
+}
+
+/**
+ * @brief Runs the lower bound search for many queries at once, interleaving their steps.
+ * 
+ * Keeps BATCH_LANES searches in flight. Each step of a search decides the next midpoint,
+ * prefetches it & moves on to the next search, so the cache misses of up to BATCH_LANES
+ * searches overlap instead of being paid one after another. A lane that finishes is
+ * refilled with the next query. Every search ends at the same lower bound as
+ * binarySearchSorted, so the results are identical: the first occurrence, or -1.
+ * 
+ * @param queries Values to search for.
+ * @param order Order in which to run the queries; null for 0..num_queries-1.
+ * @param num_queries Number of queries.
+ * @param arr, length Sorted array & its length.
+ * @param out Receives the result of query i at out[i].
+ */
+static void binarySearchBatchSorted(const int queries[], const int order[], const int num_queries,
+                                    const int arr[], const int length, int out[]) {
+    int query_idx[BATCH_LANES];
+    int base_idx[BATCH_LANES];
+    int span[BATCH_LANES];
+    int active = 0;
+    int next = 0;
+
+    while (next < num_queries || active > 0) {
+        // Refill the free lanes, resolving out-of-range queries right away like binarySearchSorted.
+        while (active < BATCH_LANES && next < num_queries) {
+            int q = order ? order[next] : next;
+            next++;
+
+            if (queries[q] > arr[length-1] || queries[q] < arr[0]) {
+                out[q] = -1;
+                continue;
+            }
+
+            query_idx[active] = q;
+            base_idx[active] = 0;
+            span[active] = length;
+            __builtin_prefetch(arr + length/2 - 1);
+            active++;
+        }
+
+        for (int lane = 0; lane < active; ) {
+            int q = query_idx[lane];
+            int value = queries[q];
+
+            if (span[lane] > 1) {
+                // Same halving step as branchlessBound, written as a conditional move.
+                int half = span[lane] / 2;
+                base_idx[lane] = arr[base_idx[lane] + half - 1] < value ? base_idx[lane] + half : base_idx[lane];
+                span[lane] -= half;
+                countComparisons(1);
+
+                if (span[lane] > 1) {
+                    __builtin_prefetch(arr + base_idx[lane] + span[lane]/2 - 1);
+                    lane++;
+                    continue;
+                }
+            }
+
+            // One element left: the lower bound is it or, if it is smaller, the one after it.
+            int idx = base_idx[lane] + (arr[base_idx[lane]] < value);
+            countComparisons(1);
+            out[q] = arr[idx] == value ? idx : -1;
+
+            // Move the last lane into this slot & process it next.
+            active--;
+            query_idx[lane] = query_idx[active];
+            base_idx[lane] = base_idx[active];
+            span[lane] = span[active];
+        }
+    }
+}
+
+/**
+ * @brief Runs the batch, optionally visiting the queries in ascending order.
+ * 
+ * Sorted queries walk the array from left to right, so consecutive searches share the
+ * cache lines near the top of the search & land close to each other at the bottom.
+ * Unless @p interleave is set, an array of at most BATCH_INTERLEAVE_MIN_LENGTH elements
+ * is searched query by query instead: it stays in the cache, so there are no misses to
+ * overlap & the lanes' bookkeeping makes the batch about 2x slower than plain searches.
+ */
+static void binarySearchBatchDispatch(const int queries[], const int num_queries, const int arr[],
+                                      const int length, int out[], const bool sort_queries, const bool interleave) {
+    if (!interleave && length <= BATCH_INTERLEAVE_MIN_LENGTH) {
+        for (int i = 0; i < num_queries; i++) {
+            out[i] = binarySearchSorted(queries[i], arr, length);
+        }
+        return;
+    }
+
+    ScratchArena& arena = threadScratchArena();
+    ScratchScope scope(arena);
+    int* order = sort_queries ? arena.allocateArray<int>(num_queries) : nullptr;
+
+    // If the permutation cannot be allocated the queries simply run in their given order.
+    if (order) {
+        for (int i = 0; i < num_queries; i++) {
+            order[i] = i;
+        }
+        introSort(order, order + num_queries, [queries](int a, int b) { return queries[a] < queries[b]; });
+    }
+
+    binarySearchBatchSorted(queries, order, num_queries, arr, length, out);
+}
+
+/**
+ * @brief Searches a sorted array for many values at once using interleaved binary searches.
+ * 
+ * Arrays that fit in an L2 cache (BATCH_INTERLEAVE_MIN_LENGTH elements) are searched query
+ * by query, which is faster there.
+ * 
+ * @param queries Pointer to the values to be searched in the array.
+ * @param num_queries Number of values in @p queries.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param out Pointer to @p num_queries integers; out[i] receives what binarySearch(queries[i], arr, length) returns.
+ * @param sort_queries If true, runs the queries in ascending order for better cache reuse. (default=false)
+ * 
+ * @return 0, if every query was searched.
+ * @return -2, if @p queries or @p out is null or if @p num_queries is a non-positive integer; @p out is not written.
+ * @return -2, if @p arr is null or if @p length is a non-positive integer; every entry of @p out is set to -2.
+ * @return -3, if @p arr is not sorted in ascending order; every entry of @p out is set to -3. Only checked in debug builds (NDEBUG undefined).
+ * 
+ * @code
+ * int sorted_arr[] = {1, 2, 3, 4, 5};
+ * int queries[] = {4, 9, 1};
+ * int out[3];
+ * 
+ * binarySearchBatch(queries, 3, sorted_arr, 5, out); // out = {3, -1, 0}
+ * @endcode
+ */
+int binarySearchBatch(const int queries[], const int num_queries, const int arr[], const int length, int out[],
+                      const bool sort_queries) {
+    if (queries == NULL || out == NULL) {
+        return -2;
+    }
+    if (num_queries <= 0) {
+        return -2;
+    }
+
+    int error = 0;
+
+    if (arr == NULL || length <= 0) {
+        error = -2;
+    }
+#ifndef NDEBUG
+    else if (!isSorted(arr, length)) {
+        error = -3;
+    }
+#endif
+
+    if (error) {
+        for (int i = 0; i < num_queries; i++) {
+            out[i] = error;
+        }
+        return error;
+    }
+
+    binarySearchBatchDispatch(queries, num_queries, arr, length, out, sort_queries, false);
+    return 0;
+}
+
+/**
+ * @brief Searches a sorted view for many values at once using interleaved binary searches.
+ * 
+ * Arrays that fit in an L2 cache (BATCH_INTERLEAVE_MIN_LENGTH elements) are searched query
+ * by query, which is faster there.
+ * 
+ * @param queries Pointer to the values to be searched in the array.
+ * @param num_queries Number of values in @p queries.
+ * @param view View created by makeSortedView or sortToView.
+ * @param out Pointer to @p num_queries integers; out[i] receives what binarySearch(queries[i], view) returns.
+ * @param sort_queries If true, runs the queries in ascending order for better cache reuse. (default=false)
+ * 
+ * @return 0, if every query was searched.
+ * @return -2, if @p queries or @p out is null or if @p num_queries is a non-positive integer; @p out is not written.
+ * @return -2, if @p view is empty; every entry of @p out is set to -2.
+ * 
+ * @code
+ * int arr[] = {5, 1, 2, 3, 4};
+ * SortedView view = sortToView(arr, 5);
+ * int queries[] = {4, 9, 1};
+ * int out[3];
+ * 
+ * binarySearchBatch(queries, 3, view, out, true); // out = {3, -1, 0}
+ * @endcode
+ */
+int binarySearchBatch(const int queries[], const int num_queries, const SortedView& view, int out[],
+                      const bool sort_queries) {
+    if (queries == NULL || out == NULL) {
+        return -2;
+    }
+    if (num_queries <= 0) {
+        return -2;
+    }
+
+    if (view.empty()) {
+        for (int i = 0; i < num_queries; i++) {
+            out[i] = -2;
+        }
+        return -2;
+    }
+
+    binarySearchBatchDispatch(queries, num_queries, view.data(), view.length(), out, sort_queries, false);
+    return 0;
+}
+
+/**
+ * @brief Searches a sorted view for many values at once, interleaving the searches whatever the array's length.
+ * 
+ * binarySearchBatch interleaves only arrays larger than an L2 cache. This variant always
+ * does, so that benchmarks can show where interleaving starts to pay off.
+ * 
+ * @return Same as binarySearchBatch on a SortedView.
+ */
+int binarySearchBatchInterleaved(const int queries[], const int num_queries, const SortedView& view, int out[],
+                                 const bool sort_queries) {
+    if (queries == NULL || out == NULL) {
+        return -2;
+    }
+    if (num_queries <= 0) {
+        return -2;
+    }
+
+    if (view.empty()) {
+        for (int i = 0; i < num_queries; i++) {
+            out[i] = -2;
+        }
+        return -2;
+    }
+
+    binarySearchBatchDispatch(queries, num_queries, view.data(), view.length(), out, sort_queries, true);
+    return 0;
+}
+
+/**
+ * @brief Returns the index of the first element not less than @p value, without branching on the comparison.
+ * 
+ * Halves the range with a conditional move instead of a jump, so the loop never
+ * mispredicts, & counts the last cache line of candidates with one SIMD compare. Both
+ * possible next midpoints are prefetched while the current comparison is in flight.
+ * lowerBound is the same search, checked for sortedness in debug builds.
+ * 
+ * @param value Number to be searched in the array.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * 
+ * @return Index of the first element >= @p value; @p length, if every element is smaller.
+ * @return -2, if @p arr is null or if @p length is a non-positive integer.
+ * 
+ * @note @p arr must be sorted in ascending order. Unlike binarySearch, this is not checked.
+ * 
+ * @code
+ * int sorted_arr[] = {1, 2, 2, 4, 5};
+ * 
+ * branchlessLowerBound(2, sorted_arr, 5); // Returns 1
+ * branchlessLowerBound(3, sorted_arr, 5); // Returns 3
+ * branchlessLowerBound(6, sorted_arr, 5); // Returns 5
+ * @endcode
+ */
+int branchlessLowerBound(const int value, const int arr[], const int length) {
+    if (arr == NULL) {
+        return -2;
+    }
+    if (length <= 0) {
+        return -2;
+    }
+
+    return (int)dsa::branchlessLowerBound(value, std::span<const int>(arr, length));
+}
+
+/**
+ * @brief Returns the index of the first occurrence of an element in the array using branchless binary search.
+ * 
+ * @param value Number to be searched in the array.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * 
+ * @return Index of @p value in the array, if found; otherwise, -1.
+ * @return -2, if @p arr is null or if @p length is a non-positive integer.
+ * 
+ * @note @p arr must be sorted in ascending order. Unlike binarySearch, this is not checked.
+ * 
+ * @code
+ * int sorted_arr[] = {1, 2, 3, 4, 5};
+ * 
+ * branchlessBinarySearch(2, sorted_arr, 5); // Returns 1
+ * branchlessBinarySearch(6, sorted_arr, 5); // Returns -1
+ * @endcode
+ */
+int branchlessBinarySearch(const int value, const int arr[], const int length) {
+    int idx = branchlessLowerBound(value, arr, length);
+
+    if (idx < 0) {
+        return idx;
+    }
+    if (idx == length || arr[idx] != value) {
+        return -1;
+    }
+
+    return idx;
+}
+
+/**
+ * @brief Returns the index of the first element not less than @p value, without branching on the comparison.
+ * 
+ * Same search as branchlessLowerBound, counting with size_t.
+ * 
+ * @param value Number to be searched in the array.
+ * @param arr Array sorted in ascending order. This is not checked.
+ * 
+ * @return Index of the first element >= @p value; arr.size(), if every element is smaller or @p arr is empty.
+ */
+size_t dsa::branchlessLowerBound(const int value, std::span<const int> arr) {
+    return branchlessBound<false>(value, arr.data(), arr.size());
+}
+
+/**
+ * @brief Returns the index of the first occurrence of an element in the array using branchless binary search.
+ * 
+ * @param value Number to be searched in the array.
+ * @param arr Array sorted in ascending order. Checked only in debug builds (NDEBUG undefined).
+ * 
+ * @return Index of the first occurrence of @p value; std::nullopt, if it is not in the array
+ *         (or, in debug builds, if @p arr is not sorted).
+ * 
+ * @code
+ * std::vector<int> sorted_arr = {1, 2, 2, 4, 5};
+ * 
+ * dsa::binarySearch(2, sorted_arr); // Returns 1
+ * dsa::binarySearch(3, sorted_arr); // Returns std::nullopt
+ * @endcode
+ */
+std::optional<size_t> dsa::binarySearch(const int value, std::span<const int> arr) {
+#ifndef NDEBUG
+    if (!isSorted(arr)) {
+        return std::nullopt;
+    }
+#endif
+
+    size_t idx = branchlessLowerBound(value, arr);
+
+    if (idx == arr.size() || arr[idx] != value) {
+        return std::nullopt;
+    }
+
+    return idx;
+}
+
+/**
+ * @brief Checks the array a range query was given: non-null, non-empty &, in debug builds, sorted.
+ * 
+ * @return 0, if the query may run; -2, if @p arr is null or @p length is non-positive; -3, if @p arr is not sorted.
+ */
+static int checkSearchArray(const int arr[], const int length) {
+    if (arr == NULL) {
+        return -2;
+    }
+    if (length <= 0) {
+        return -2;
+    }
+#ifndef NDEBUG
+    if (!isSorted(arr, length)) {
+        return -3;
+    }
+#endif
+
+    return 0;
+}
+
+/**
+ * @brief Finds [first, last), the positions equal to @p value, with two bound searches; the second only searches from first on.
+ */
+static void equalRangeSorted(const int value, const int arr[], const size_t length, size_t* first, size_t* last) {
+    *first = branchlessBound<false>(value, arr, length);
+    *last = *first + branchlessBound<true>(value, arr + *first, length - *first);
+}
+
+/**
+ * @brief Returns the number of elements in [lo, hi] with two bound searches; the second only searches from the first on.
+ */
+static size_t countInRangeSorted(const int lo, const int hi, const int arr[], const size_t length) {
+    if (lo > hi) {
+        return 0;
+    }
+
+    size_t first = branchlessBound<false>(lo, arr, length);
+    return branchlessBound<true>(hi, arr + first, length - first);
+}
+
+/**
+ * @brief Returns the index of the first element not less than @p value in a sorted array.
+ * 
+ * Same search as branchlessLowerBound: conditional-move halving & one SIMD count over the last cache line.
+ * 
+ * @param value Number to be searched in the array.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * 
+ * @return Index of the first element >= @p value; @p length, if every element is smaller.
+ * @return -2, if @p arr is null or if @p length is a non-positive integer.
+ * @return -3, if @p arr is not sorted in ascending order. Only checked in debug builds (NDEBUG undefined).
+ * 
+ * @code
+ * int sorted_arr[] = {1, 2, 2, 4, 5};
+ * 
+ * lowerBound(2, sorted_arr, 5); // Returns 1
+ * lowerBound(3, sorted_arr, 5); // Returns 3
+ * lowerBound(6, sorted_arr, 5); // Returns 5
+ * @endcode
+ */
+int lowerBound(const int value, const int arr[], const int length) {
+    int error = checkSearchArray(arr, length);
+    if (error) {
+        return error;
+    }
+
+    return (int)branchlessBound<false>(value, arr, length);
+}
+
+/**
+ * @brief Returns the index of the first element not less than @p value in a sorted view, in O(log n).
+ * 
+ * @return Index of the first element >= @p value; view.length(), if every element is smaller.
+ * @return -2, if @p view is empty.
+ */
+int lowerBound(const int value, const SortedView& view) {
+    if (view.empty()) {
+        return -2;
+    }
+
+    return (int)branchlessBound<false>(value, view.data(), view.length());
+}
+
+/**
+ * @brief Returns the index of the first element greater than @p value in a sorted array.
+ * 
+ * @param value Number to be searched in the array.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * 
+ * @return Index of the first element > @p value; @p length, if no element is greater.
+ * @return -2, if @p arr is null or if @p length is a non-positive integer.
+ * @return -3, if @p arr is not sorted in ascending order. Only checked in debug builds (NDEBUG undefined).
+ * 
+ * @code
+ * int sorted_arr[] = {1, 2, 2, 4, 5};
+ * 
+ * upperBound(2, sorted_arr, 5); // Returns 3
+ * upperBound(0, sorted_arr, 5); // Returns 0
+ * upperBound(5, sorted_arr, 5); // Returns 5
+ * @endcode
+ */
+int upperBound(const int value, const int arr[], const int length) {
+    int error = checkSearchArray(arr, length);
+    if (error) {
+        return error;
+    }
+
+    return (int)branchlessBound<true>(value, arr, length);
+}
+
+/**
+ * @brief Returns the index of the first element greater than @p value in a sorted view, in O(log n).
+ * 
+ * @return Index of the first element > @p value; view.length(), if no element is greater.
+ * @return -2, if @p view is empty.
+ */
+int upperBound(const int value, const SortedView& view) {
+    if (view.empty()) {
+        return -2;
+    }
+
+    return (int)branchlessBound<true>(value, view.data(), view.length());
+}
+
+/**
+ * @brief Finds every position holding @p value in a sorted array.
+ * 
+ * @param value Number to be searched in the array.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param first Receives the index of the first element >= @p value.
+ * @param last Receives the index of the first element > @p value; arr[*first..*last) all equal @p value.
+ * 
+ * @return Number of elements equal to @p value, *last - *first.
+ * @return -2, if @p arr, @p first or @p last is null or if @p length is a non-positive integer.
+ * @return -3, if @p arr is not sorted in ascending order. Only checked in debug builds (NDEBUG undefined).
+ * 
+ * @code
+ * int sorted_arr[] = {1, 2, 2, 4, 5};
+ * int first, last;
+ * 
+ * equalRange(2, sorted_arr, 5, &first, &last); // Returns 2; first = 1, last = 3
+ * equalRange(3, sorted_arr, 5, &first, &last); // Returns 0; first = last = 3
+ * @endcode
+ */
+int equalRange(const int value, const int arr[], const int length, int* first, int* last) {
+    if (first == NULL || last == NULL) {
+        return -2;
+    }
+
+    int error = checkSearchArray(arr, length);
+    if (error) {
+        return error;
+    }
+
+    size_t range_first, range_last;
+    equalRangeSorted(value, arr, length, &range_first, &range_last);
+
+    *first = (int)range_first;
+    *last = (int)range_last;
+    return *last - *first;
+}
+
+/**
+ * @brief Finds every position holding @p value in a sorted view, in O(log n).
+ * 
+ * @return Number of elements equal to @p value; -2, if @p view is empty or if @p first or @p last is null.
+ */
+int equalRange(const int value, const SortedView& view, int* first, int* last) {
+    if (first == NULL || last == NULL || view.empty()) {
+        return -2;
+    }
+
+    size_t range_first, range_last;
+    equalRangeSorted(value, view.data(), view.length(), &range_first, &range_last);
+
+    *first = (int)range_first;
+    *last = (int)range_last;
+    return *last - *first;
+}
+
+/**
+ * @brief Counts the elements of a sorted array in [lo, hi], in O(log n).
+ * 
+ * @param lo, hi Bounds of the range, both included.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * 
+ * @return Number of elements x with lo <= x <= hi; 0, if @p lo > @p hi.
+ * @return -2, if @p arr is null or if @p length is a non-positive integer.
+ * @return -3, if @p arr is not sorted in ascending order. Only checked in debug builds (NDEBUG undefined).
+ * 
+ * @code
+ * int sorted_arr[] = {1, 2, 2, 4, 5};
+ * 
+ * countInRange(2, 4, sorted_arr, 5); // Returns 3
+ * countInRange(6, 9, sorted_arr, 5); // Returns 0
+ * @endcode
+ */
+int countInRange(const int lo, const int hi, const int arr[], const int length) {
+    int error = checkSearchArray(arr, length);
+    if (error) {
+        return error;
+    }
+
+    return (int)countInRangeSorted(lo, hi, arr, length);
+}
+
+/**
+ * @brief Counts the elements of a sorted view in [lo, hi], in O(log n).
+ * 
+ * @return Number of elements x with lo <= x <= hi; 0, if @p lo > @p hi; -2, if @p view is empty.
+ */
+int countInRange(const int lo, const int hi, const SortedView& view) {
+    if (view.empty()) {
+        return -2;
+    }
+
+    return (int)countInRangeSorted(lo, hi, view.data(), view.length());
+}
+
+/**
+ * @brief Returns the index of the first element not less than @p value.
+ * 
+ * @param arr Array sorted in ascending order. This is not checked.
+ * 
+ * @return Index of the first element >= @p value; arr.size(), if every element is smaller or @p arr is empty.
+ */
+size_t dsa::lowerBound(const int value, std::span<const int> arr) {
+    return branchlessBound<false>(value, arr.data(), arr.size());
+}
+
+/**
+ * @brief Returns the index of the first element greater than @p value.
+ * 
+ * @param arr Array sorted in ascending order. This is not checked.
+ * 
+ * @return Index of the first element > @p value; arr.size(), if no element is greater or @p arr is empty.
+ */
+size_t dsa::upperBound(const int value, std::span<const int> arr) {
+    return branchlessBound<true>(value, arr.data(), arr.size());
+}
+
+/**
+ * @brief Returns [first, last), the positions holding @p value.
+ * 
+ * @param arr Array sorted in ascending order. This is not checked.
+ * 
+ * @code
+ * std::vector<int> sorted_arr = {1, 2, 2, 4, 5};
+ * 
+ * auto [first, last] = dsa::equalRange(2, sorted_arr); // first = 1, last = 3
+ * @endcode
+ */
+std::pair<size_t, size_t> dsa::equalRange(const int value, std::span<const int> arr) {
+    size_t first, last;
+    equalRangeSorted(value, arr.data(), arr.size(), &first, &last);
+    return {first, last};
+}
+
+/**
+ * @brief Returns the number of elements in [lo, hi]; 0, if @p lo > @p hi.
+ * 
+ * @param arr Array sorted in ascending order. This is not checked.
+ */
+size_t dsa::countInRange(const int lo, const int hi, std::span<const int> arr) {
+    return countInRangeSorted(lo, hi, arr.data(), arr.size());
+}
+
+/**
+ * @brief Returns the index of the first element not less than @p value, probing where evenly spread keys would put it.
+ * 
+ * Each step guesses the position by linear interpolation between the values at the ends
+ * of the range, which are kept, so a step reads a single new element. On near-uniform
+ * keys, such as timestamps, two or three steps leave at most BOUND_SIMD_SPAN elements,
+ * which are counted with one SIMD scan. On skewed keys, guesses creep: the first step that
+ * cuts less than 1/INTERPOLATION_MIN_CUT of the range hands the search over to
+ * branchlessBound on the whole array, whose first levels are shared by every search &
+ * stay in the cache. That bounds the worst case at O(log n) reads.
+ * 
+ * @param value Number to be searched in the array.
+ * @param arr, length Array sorted in ascending order & its length, which may be 0.
+ * 
+ * @return Index of the bound; @p length, if every element is below it.
+ */
+static size_t interpolationBound(const int value, const int arr[], const size_t length) {
+    countComparisons(2);
+    if (length == 0 || arr[0] >= value) {
+        return 0;
+    }
+    if (arr[length-1] < value) {
+        return length;
+    }
+
+    // The bound is in [lo, hi]: arr[lo-1] < value <= arr[hi], the values kept as doubles for the guess.
+    size_t lo = 1;
+    size_t hi = length - 1;
+    double lo_val = arr[0];
+    double hi_val = arr[length-1];
+
+    while (hi - lo > BOUND_SIMD_SPAN) {
+        size_t range = hi - lo;
+        size_t pos = lo - 1 + (size_t)((value - lo_val) / (hi_val - lo_val) * (range + 1));
+        pos = pos < lo ? lo : pos >= hi ? hi - 1 : pos;
+
+        countComparisons(1);
+        if (arr[pos] < value) {
+            lo = pos + 1;
+            lo_val = arr[pos];
+        }
+        else {
+            hi = pos;
+            hi_val = arr[pos];
+        }
+
+        if (hi - lo > range - range/INTERPOLATION_MIN_CUT) {
+            return branchlessBound<false>(value, arr, length);
+        }
+    }
+
+    return lo + branchlessBound<false>(value, arr + lo, hi - lo);
+}
+
+/**
+ * @brief Returns the index of the first element not less than @p value, galloping from the front.
+ * 
+ * Probes indices 1, 2, 4, 8, ... until one is not below @p value, then searches the last
+ * doubling with branchlessBound: O(log i) for a bound at index i, however long the array.
+ * 
+ * @param value Number to be searched in the array.
+ * @param arr, length Array sorted in ascending order & its length, which may be 0.
+ * 
+ * @return Index of the bound; @p length, if every element is below it.
+ */
+static size_t exponentialBound(const int value, const int arr[], const size_t length) {
+    countComparisons(1);
+    if (length == 0 || arr[0] >= value) {
+        return 0;
+    }
+
+    size_t bound = 1;
+    while (bound < length && arr[bound] < value) {
+        countComparisons(1);
+        bound *= 2;
+    }
+
+    // arr[bound/2] < value, & arr[bound] >= value unless bound passed the end.
+    size_t lo = bound/2 + 1;
+    size_t hi = bound < length ? bound : length;
+
+    return lo + branchlessBound<false>(value, arr + lo, hi - lo);
+}
+
+/**
+ * @brief Returns the index of the first occurrence of an element in the array using interpolation search.
+ * 
+ * Suited to near-uniformly distributed keys, such as timestamps: O(log log n) probes,
+ * often two, instead of binary search's log2(n). On skewed keys, it gives up interpolating
+ * as soon as a probe cuts the range by less than a quarter & finishes as binarySearch
+ * does, so the worst case stays O(log n), a probe or two slower than binarySearch.
+ * 
+ * @param value Number to be searched in the array.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * 
+ * @return Index of the first occurrence of @p value in the array, if found; otherwise, -1.
+ * @return -2, if @p arr is null or if @p length is a non-positive integer.
+ * @return -3, if @p arr is not sorted in ascending order. Only checked in debug builds (NDEBUG undefined).
+ * 
+ * @code
+ * int sorted_arr[] = {10, 20, 30, 30, 50};
+ * 
+ * interpolationSearch(30, sorted_arr, 5); // Returns 2
+ * interpolationSearch(40, sorted_arr, 5); // Returns -1
+ * @endcode
+ */
+int interpolationSearch(const int value, const int arr[], const int length) {
+    int status = checkSearchArray(arr, length);
+    if (status != 0) {
+        return status;
+    }
+    if (value < arr[0] || value > arr[length-1]) {
+        return -1;
+    }
+
+    size_t idx = interpolationBound(value, arr, length);
+    return arr[idx] == value ? (int)idx : -1;
+}
+
+/**
+ * @brief Returns the index of the first occurrence of an element in a sorted view using interpolation search.
+ * 
+ * @return Index of the first occurrence of @p value, if found; otherwise, -1.
+ * @return -2, if @p view is empty.
+ */
+int interpolationSearch(const int value, const SortedView& view) {
+    if (view.empty()) {
+        return -2;
+    }
+
+    const int* arr = view.data();
+    if (value < arr[0] || value > arr[view.length()-1]) {
+        return -1;
+    }
+
+    size_t idx = interpolationBound(value, arr, view.length());
+    return arr[idx] == value ? (int)idx : -1;
+}
+
+/**
+ * @brief Returns the index of the first occurrence of an element in the array using exponential search.
+ * 
+ * Costs O(log i) for an element at index i, so it beats binarySearch when the elements
+ * searched for sit near the front of a much longer array, e.g. the newest entries of a
+ * large sorted log. It never reads past the doubling that contains the element.
+ * 
+ * @param value Number to be searched in the array.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * 
+ * @return Index of the first occurrence of @p value in the array, if found; otherwise, -1.
+ * @return -2, if @p arr is null or if @p length is a non-positive integer.
+ * @return -3, if @p arr is not sorted in ascending order. Only checked in debug builds (NDEBUG undefined).
+ * 
+ * @code
+ * int sorted_arr[] = {1, 2, 2, 4, 5};
+ * 
+ * exponentialSearch(2, sorted_arr, 5); // Returns 1
+ * exponentialSearch(3, sorted_arr, 5); // Returns -1
+ * @endcode
+ */
+int exponentialSearch(const int value, const int arr[], const int length) {
+    int status = checkSearchArray(arr, length);
+    if (status != 0) {
+        return status;
+    }
+
+    size_t idx = exponentialBound(value, arr, length);
+    return idx < (size_t)length && arr[idx] == value ? (int)idx : -1;
+}
+
+/**
+ * @brief Returns the index of the first occurrence of an element in a sorted view using exponential search.
+ * 
+ * @return Index of the first occurrence of @p value, if found; otherwise, -1.
+ * @return -2, if @p view is empty.
+ */
+int exponentialSearch(const int value, const SortedView& view) {
+    if (view.empty()) {
+        return -2;
+    }
+
+    size_t idx = exponentialBound(value, view.data(), view.length());
+    return idx < (size_t)view.length() && view.data()[idx] == value ? (int)idx : -1;
+}
+
+/**
+ * @brief Returns the index of the first occurrence of an element using interpolation search.
+ * 
+ * @param arr Array sorted in ascending order. This is not checked.
+ * 
+ * @return Index of the first occurrence of @p value; std::nullopt, if it is not in the array.
+ */
+std::optional<size_t> dsa::interpolationSearch(const int value, std::span<const int> arr) {
+    size_t idx = interpolationBound(value, arr.data(), arr.size());
+
+    if (idx == arr.size() || arr[idx] != value) {
+        return std::nullopt;
+    }
+
+    return idx;
+}
+
+/**
+ * @brief Returns the index of the first occurrence of an element using exponential search, in O(log i) for index i.
+ * 
+ * @param arr Array sorted in ascending order. This is not checked.
+ * 
+ * @return Index of the first occurrence of @p value; std::nullopt, if it is not in the array.
+ * 
+ * @code
+ * std::span<const int> timestamps = ...; // Billions of distinct, sorted timestamps
+ * 
+ * dsa::exponentialSearch(timestamps[5], timestamps); // Returns 5, reading only the first 9 elements
+ * @endcode
+ */
+std::optional<size_t> dsa::exponentialSearch(const int value, std::span<const int> arr) {
+    size_t idx = exponentialBound(value, arr.data(), arr.size());
+
+    if (idx == arr.size() || arr[idx] != value) {
+        return std::nullopt;
+    }
+
+    return idx;
+}
+
+/**
+ * @brief Fills the subtree rooted at node @p k with arr[i..] in order.
+ * 
+ * @return Index of the next element of @p arr to place.
+ */
+static int fillEytzinger(const int arr[], int i, const size_t k, EytzingerIndex* index) {
+    if (k <= (size_t)index->length) {
+        i = fillEytzinger(arr, i, 2*k, index);
+        index->keys[k] = arr[i];
+        index->ranks[k] = i;
+        i++;
+        i = fillEytzinger(arr, i, 2*k + 1, index);
+    }
+
+    return i;
+}
+
+/**
+ * @brief Allocates a cache-line aligned buffer of @p count integers.
+ * 
+ * @return Pointer to the buffer; nullptr, if it could not be allocated.
+ */
+static int* allocateAligned(const size_t count) {
+    size_t bytes = count * sizeof(int);
+    bytes = (bytes + CACHE_LINE_BYTES - 1) / CACHE_LINE_BYTES * CACHE_LINE_BYTES;
+
+    return (int*)std::aligned_alloc(CACHE_LINE_BYTES, bytes);
+}
+
+/**
+ * @brief Builds an Eytzinger (BFS-order) copy of a sorted array.
+ * 
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param index Pointer to the index to fill. Release it with freeEytzingerIndex.
+ * 
+ * @return 0, if the index was built.
+ * @return -2, if @p arr or @p index is null or if @p length is a non-positive integer.
+ * @return -3, if @p arr is not sorted in ascending order.
+ * @return -4, if memory for the index could not be allocated.
+ * 
+ * @code
+ * int sorted_arr[] = {1, 2, 3, 4, 5};
+ * EytzingerIndex index;
+ * 
+ * buildEytzingerIndex(sorted_arr, 5, &index); // index.keys = {_, 4, 2, 5, 1, 3}
+ * eytzingerSearch(2, &index); // Returns 1
+ * freeEytzingerIndex(&index);
+ * @endcode
+ */
+int buildEytzingerIndex(const int arr[], const int length, EytzingerIndex* index) {
+    if (arr == NULL || index == NULL) {
+        return -2;
+    }
+    if (length <= 0) {
+        return -2;
+    }
+    if (!isSorted(arr, length)) {
+        return -3;
+    }
+
+    index->length = length;
+    index->keys = allocateAligned((size_t)length + 1);
+    index->ranks = allocateAligned((size_t)length + 1);
+
+    if (!index->keys || !index->ranks) {
+        freeEytzingerIndex(index);
+        return -4;
+    }
+
+    fillEytzinger(arr, 0, 1, index);
+    return 0;
+}
+
+/**
+ * @brief Releases the memory held by an Eytzinger index.
+ * 
+ * @param index Pointer to the index. Null pointers are ignored.
+ */
+void freeEytzingerIndex(EytzingerIndex* index) {
+    if (!index) {
+        return;
+    }
+
+    std::free(index->keys);
+    std::free(index->ranks);
+    index->keys = nullptr;
+    index->ranks = nullptr;
+    index->length = 0;
+}
+
+/**
+ * @brief Returns the index of the first occurrence of an element in the original sorted array using an Eytzinger index.
+ * 
+ * Walks down the implicit tree with a branchless step. Node k's descendants four levels
+ * down fill one cache line starting at keys[16k], which is prefetched on every step,
+ * so the memory latency of deep levels overlaps with the comparisons above them.
+ * 
+ * @param value Number to be searched in the array.
+ * @param index Pointer to an index built by buildEytzingerIndex.
+ * 
+ * @return Index of @p value in the original sorted array, if found; otherwise, -1.
+ * @return -2, if @p index is null or empty.
+ * 
+ * @code
+ * int sorted_arr[] = {1, 2, 3, 4, 5};
+ * EytzingerIndex index;
+ * buildEytzingerIndex(sorted_arr, 5, &index);
+ * 
+ * eytzingerSearch(4, &index); // Returns 3
+ * eytzingerSearch(6, &index); // Returns -1
+ * @endcode
+ */
+int eytzingerSearch(const int value, const EytzingerIndex* index) {
+    if (index == NULL || index->keys == NULL) {
+        return -2;
+    }
+    if (index->length <= 0) {
+        return -2;
+    }
+
+    const int* keys = index->keys;
+    const size_t n = (size_t)index->length;
+    size_t k = 1;
+
+    while (k <= n) {
+        __builtin_prefetch(keys + 16*k);
+        k = 2*k + (keys[k] < value);
+        countComparisons(1);
+    }
+
+    // The walk ends below the lower bound: strip the trailing right turns & the final left turn.
+    k >>= __builtin_ffsll(~(long long)k);
+
+    if (k == 0 || keys[k] != value) {
+        return -1;
+    }
+
+    return index->ranks[k];
+}
@@ -0,0 +1,452 @@
+/**
+ * @file external_sort.cpp
+ * @brief External Merge Sort for array files larger than memory.
+ *
+ * Provides function definitions for the out-of-core sort declared in sort.h. The input
+ * is read in runs that fit the memory budget; each run is sorted in memory & spilled to
+ * a temporary file. The runs are then merged with a loser tree, as many at a time as
+ * the budget allows large read buffers for, until one merge writes the output.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <new>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include "array_file.h"
+#include "scratch_arena.h"
+#include "sort.h"
+
+using std::bad_alloc;
+using std::vector;
+
+// ====== External Sorting Functions ======
+int externalSort(const char*, const char*, const size_t, void (*sort)(int[], const int, bool), bool, const char*);
+static bool sameFile(const int, const char*);
+
+// Smallest memory budget externalSort accepts.
+static const size_t MIN_MEMORY_BYTES = 1 << 20;
+// Smallest read buffer per run during a merge; caps how many runs one pass merges.
+static const size_t MIN_MERGE_BUFFER_BYTES = 1 << 16;
+// Loser tree key of a run with no elements left. Loses to every int key.
+static const int64_t EXHAUSTED_KEY = INT64_MAX;
+
+/**
+ * @brief Sorted run in a temporary file, in elements.
+ */
+struct Run {
+    uint64_t offset;
+    uint64_t length;
+};
+
+/**
+ * @brief Buffered reader over one run during a merge.
+ */
+struct RunReader {
+    uint64_t next;
+    uint64_t end;
+    int* buffer;
+    size_t capacity;
+    size_t pos;
+    size_t count;
+};
+
+
+/**
+ * @brief Reads exactly @p bytes at @p offset of @p fd, retrying short reads.
+ */
+static bool readFully(const int fd, void* buffer, size_t bytes, off_t offset) {
+    char* p = (char*)buffer;
+
+    while (bytes > 0) {
+        ssize_t read_bytes = pread(fd, p, bytes, offset);
+        if (read_bytes <= 0) {
+            return false;
+        }
+        p += read_bytes;
+        bytes -= read_bytes;
+        offset += read_bytes;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Writes exactly @p bytes at the current position of @p fd, retrying short writes.
+ */
+static bool writeFully(const int fd, const void* buffer, size_t bytes) {
+    const char* p = (const char*)buffer;
+
+    while (bytes > 0) {
+        ssize_t written = write(fd, p, bytes);
+        if (written <= 0) {
+            return false;
+        }
+        p += written;
+        bytes -= written;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Creates an anonymous temporary file in @p temp_dir. It is unlinked at once & disappears when closed.
+ *
+ * @return File descriptor, or -1.
+ */
+static int createTempFile(const char* temp_dir) {
+    std::string path = std::string(temp_dir) + "/dsa-runs-XXXXXX";
+
+    int fd = mkstemp(&path[0]);
+    if (fd >= 0) {
+        unlink(path.c_str());
+    }
+
+    return fd;
+}
+
+/**
+ * @brief Returns true if @p path names the file open as @p fd, e.g. through a different relative path or a link.
+ */
+static bool sameFile(const int fd, const char* path) {
+    struct stat opened, named;
+
+    return fstat(fd, &opened) == 0 && stat(path, &named) == 0 &&
+           opened.st_dev == named.st_dev && opened.st_ino == named.st_ino;
+}
+
+/**
+ * @brief Maps an element to its loser tree key; smaller keys are output first.
+ */
+static inline int64_t mergeKey(const int value, const bool desc) {
+    return desc ? -(int64_t)value : (int64_t)value;
+}
+
+/**
+ * @brief Replays the matches from leaf @p s to the root after its key changed.
+ *
+ * Each internal node tree[1..k) keeps the loser of its match & the winner moves up;
+ * tree[0] receives the overall winner. Ties go to the lower run, so the merge is stable.
+ */
+static void loserTreeAdjust(int tree[], const int64_t keys[], const int k, int s) {
+    for (int t = (s + k) >> 1; t > 0; t >>= 1) {
+        int other = tree[t];
+
+        if (keys[s] > keys[other] || (keys[s] == keys[other] && s > other)) {
+            tree[t] = s;
+            s = other;
+        }
+    }
+
+    tree[0] = s;
+}
+
+/**
+ * @brief Builds the loser tree over keys[0..k).
+ *
+ * @param keys Array of k+1 keys; keys[k] is scratch for a sentinel that wins every match.
+ */
+static void loserTreeBuild(int tree[], int64_t keys[], const int k) {
+    keys[k] = INT64_MIN;
+    for (int t = 0; t < k; t++) {
+        tree[t] = k;
+    }
+
+    // Every leaf displaces one sentinel on its path; the last leaf finds none & crowns the real winner.
+    for (int s = k-1; s >= 0; s--) {
+        loserTreeAdjust(tree, keys, k, s);
+    }
+}
+
+/**
+ * @brief Refills a reader's buffer with the next elements of its run.
+ *
+ * @return False, if the read failed.
+ */
+static bool refillRun(const int fd, RunReader* reader) {
+    size_t count = (size_t)std::min<uint64_t>(reader->capacity, reader->end - reader->next);
+
+    if (count > 0 && !readFully(fd, reader->buffer, count*sizeof(int), reader->next*sizeof(int))) {
+        return false;
+    }
+
+    reader->next += count;
+    reader->pos = 0;
+    reader->count = count;
+    return true;
+}
+
+/**
+ * @brief Merges sorted runs of @p in_fd & appends the result at the current position of @p out_fd.
+ *
+ * @param in_fd Temporary file holding the runs.
+ * @param runs Runs to merge.
+ * @param k Number of runs to merge.
+ * @param out_fd File to append the merged elements to.
+ * @param buffer Memory for the k read buffers & the write buffer.
+ * @param buffer_elements Number of ints in @p buffer.
+ * @param desc If true, the runs are sorted in descending order; otherwise, ascending order.
+ *
+ * @return False, if a read or write failed.
+ */
+static bool mergeRuns(const int in_fd, const Run runs[], const int k, const int out_fd,
+                      int buffer[], const size_t buffer_elements, const bool desc) {
+    // One share per run & one, twice as large, for the output so writes stay long.
+    size_t share = buffer_elements / (k + 2);
+    int* out = buffer + k*share;
+    size_t out_capacity = buffer_elements - k*share;
+    size_t out_count = 0;
+
+    vector<RunReader> readers(k);
+    vector<int64_t> keys(k + 1);
+    vector<int> tree(k);
+
+    for (int i = 0; i < k; i++) {
+        readers[i] = {runs[i].offset, runs[i].offset + runs[i].length, buffer + i*share, share, 0, 0};
+        if (!refillRun(in_fd, &readers[i])) {
+            return false;
+        }
+        keys[i] = readers[i].count > 0 ? mergeKey(readers[i].buffer[0], desc) : EXHAUSTED_KEY;
+    }
+
+    loserTreeBuild(tree.data(), keys.data(), k);
+
+    while (keys[tree[0]] != EXHAUSTED_KEY) {
+        int winner = tree[0];
+        RunReader& reader = readers[winner];
+
+        out[out_count++] = reader.buffer[reader.pos++];
+        if (out_count == out_capacity) {
+            if (!writeFully(out_fd, out, out_count*sizeof(int))) {
+                return false;
+            }
+            out_count = 0;
+        }
+
+        if (reader.pos == reader.count && !refillRun(in_fd, &reader)) {
+            return false;
+        }
+        keys[winner] = reader.pos < reader.count ? mergeKey(reader.buffer[reader.pos], desc) : EXHAUSTED_KEY;
+        loserTreeAdjust(tree.data(), keys.data(), k, winner);
+    }
+
+    return writeFully(out_fd, out, out_count*sizeof(int));
+}
+
+/**
+ * @brief Opens an array file for sequential reading & returns its length.
+ *
+ * @return File descriptor; -4, if the file could not be opened;
+ *         -5, if it is not a valid array file.
+ */
+static int openInput(const char* path, uint64_t* length) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -4;
+    }
+
+    ArrayFileHeader header;
+    struct stat info;
+
+    if (fstat(fd, &info) != 0) {
+        close(fd);
+        return -4;
+    }
+    if ((size_t)info.st_size < sizeof(header) || !readFully(fd, &header, sizeof(header), 0) ||
+        std::memcmp(header.magic, ARRAY_FILE_MAGIC, sizeof(header.magic)) != 0 ||
+        header.byte_order != ARRAY_FILE_BYTE_ORDER ||
+        (uint64_t)info.st_size != sizeof(header) + header.length*sizeof(int)) {
+        close(fd);
+        return -5;
+    }
+
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    *length = header.length;
+    return fd;
+}
+
+/**
+ * @brief Sorts an array file of any size within a memory budget & writes the result as a new array file.
+ *
+ * Half the budget holds one run & the other half is left to sorts that take an equal-sized
+ * scratch buffer from threadScratchArena() (radixSort, parallelMergeSort). Once the runs are
+ * formed, the run buffer & the arena's memory are released before the whole budget is taken
+ * for the merge buffers, so the peak stays within the budget. Runs are spilled to one temporary file & merged in passes
+ * of as many runs as fit with a read buffer of at least 64 KiB each, ping-ponging with a second
+ * temporary file, until a single merge writes the output. An input that fits in one run is sorted
+ * without temporary files.
+ *
+ * The output is written to a temporary file next to it & renamed over @p output only once it is
+ * complete, so a failed sort leaves no truncated file behind whose header claims it is sorted.
+ *
+ * @param input Path of the array file to sort. Its length may exceed INT_MAX.
+ * @param output Path of the array file to write. Must not name the same file as @p input.
+ * @param memory_bytes Memory budget in bytes; at least 1 MiB.
+ * @param sort Sorting function from sort.h to sort each run with. If null, uses introSort. (default=nullptr)
+ * @param desc If true, sorts in descending order; otherwise, ascending order. (default=false)
+ * @param temp_dir Directory for the temporary files. If null, uses $TMPDIR or /tmp. (default=nullptr)
+ *
+ * @return 0, if the output was written.
+ * @return -2, if @p input or @p output is null, if they name the same file or if @p memory_bytes is below 1 MiB.
+ * @return -4, if a file could not be read or written or the buffers could not be allocated.
+ * @return -5, if @p input is not a valid array file.
+ *
+ * @code
+ * // Sort a 32 GiB file with 4 GiB of memory.
+ * externalSort("huge.bin", "huge_sorted.bin", (size_t)4 << 30, [](int arr[], const int length, bool desc) {
+ *     radixSort(arr, length, desc);
+ * });
+ * @endcode
+ */
+int externalSort(const char* input, const char* output, const size_t memory_bytes,
+                 void (*sort)(int[], const int, bool), bool desc, const char* temp_dir) {
+    if (!input || !output || std::strcmp(input, output) == 0) {
+        return -2;
+    }
+    if (memory_bytes < MIN_MEMORY_BYTES) {
+        return -2;
+    }
+    if (!temp_dir) {
+        temp_dir = std::getenv("TMPDIR") ? std::getenv("TMPDIR") : "/tmp";
+    }
+
+    uint64_t length;
+    int in_fd = openInput(input, &length);
+    if (in_fd < 0) {
+        return in_fd;
+    }
+    if (sameFile(in_fd, output)) {
+        close(in_fd);
+        return -2;
+    }
+
+    size_t buffer_elements = memory_bytes / sizeof(int);
+    size_t run_capacity = std::min<size_t>(buffer_elements / 2, INT_MAX);
+    if (length < run_capacity) {
+        run_capacity = std::max<uint64_t>(length, 1);
+    }
+    int* buffer;
+
+    try {
+        buffer = new int[run_capacity];
+    } catch (const bad_alloc& e) {
+        close(in_fd);
+        return -4;
+    }
+
+    std::string out_path = std::string(output) + ".dsa-XXXXXX";
+    int out_fd = mkstemp(&out_path[0]);
+    if (out_fd >= 0) {
+        fchmod(out_fd, 0644);
+    }
+    int run_fds[2] = {-1, -1};
+    vector<Run> runs;
+    bool ok = out_fd >= 0;
+
+    ArrayFileHeader header = {};
+    std::memcpy(header.magic, ARRAY_FILE_MAGIC, sizeof(header.magic));
+    header.byte_order = ARRAY_FILE_BYTE_ORDER;
+    header.flags = desc && length > 1 ? 0 : ARRAY_FILE_SORTED;
+    header.length = length;
+    ok = ok && writeFully(out_fd, &header, sizeof(header));
+
+    // Run formation: sort memory-sized pieces of the input. A single piece goes straight to the output.
+    for (uint64_t start = 0; ok && start < length; start += run_capacity) {
+        int count = (int)std::min<uint64_t>(run_capacity, length - start);
+
+        ok = readFully(in_fd, buffer, count*sizeof(int), sizeof(header) + start*sizeof(int));
+        if (!ok) break;
+
+        if (sort) {
+            sort(buffer, count, desc);
+        } else {
+            introSort(buffer, count, desc);
+        }
+
+        if (length <= run_capacity) {
+            ok = writeFully(out_fd, buffer, count*sizeof(int));
+            break;
+        }
+
+        if (run_fds[0] < 0) {
+            run_fds[0] = createTempFile(temp_dir);
+            ok = run_fds[0] >= 0;
+            if (!ok) break;
+        }
+        ok = writeFully(run_fds[0], buffer, count*sizeof(int));
+        runs.push_back({start, (uint64_t)count});
+    }
+    close(in_fd);
+
+    // The merge needs the whole budget: swap the run buffer for it & return the sort's scratch.
+    if (ok && !runs.empty()) {
+        delete[] buffer;
+        threadScratchArena().trim();
+
+        try {
+            buffer = new int[buffer_elements];
+        } catch (const bad_alloc& e) {
+            buffer = nullptr;
+            ok = false;
+        }
+    }
+
+    // Merge passes: while too many runs remain for one merge, merge groups into the other temporary file.
+    size_t max_fan_in = std::max<size_t>(2, buffer_elements*sizeof(int) / MIN_MERGE_BUFFER_BYTES - 2);
+    int current = 0;
+
+    while (ok && runs.size() > max_fan_in) {
+        if (run_fds[1-current] < 0) {
+            run_fds[1-current] = createTempFile(temp_dir);
+        }
+        int next_fd = run_fds[1-current];
+        ok = next_fd >= 0 && ftruncate(next_fd, 0) == 0 && lseek(next_fd, 0, SEEK_SET) == 0;
+
+        vector<Run> merged;
+        uint64_t offset = 0;
+
+        for (size_t i = 0; ok && i < runs.size(); i += max_fan_in) {
+            int k = (int)std::min(max_fan_in, runs.size() - i);
+            uint64_t merged_length = 0;
+            for (int r = 0; r < k; r++) {
+                merged_length += runs[i+r].length;
+            }
+
+            ok = mergeRuns(run_fds[current], &runs[i], k, next_fd, buffer, buffer_elements, desc);
+            merged.push_back({offset, merged_length});
+            offset += merged_length;
+        }
+
+        runs.swap(merged);
+        current = 1 - current;
+    }
+
+    if (ok && !runs.empty()) {
+        ok = mergeRuns(run_fds[current], runs.data(), (int)runs.size(), out_fd, buffer, buffer_elements, desc);
+    }
+
+    delete[] buffer;
+    for (int fd : run_fds) {
+        if (fd >= 0) close(fd);
+    }
+    if (out_fd >= 0 && close(out_fd) != 0) {
+        ok = false;
+    }
+    if (out_fd >= 0 && (!ok || rename(out_path.c_str(), output) != 0)) {
+        unlink(out_path.c_str());
+        ok = false;
+    }
+
+    return ok ? 0 : -4;
+}
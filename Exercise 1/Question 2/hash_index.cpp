@@ -0,0 +1,261 @@
+/**
+ * @file hash_index.cpp
+ * @brief Hash index - Open-addressing hash table with SIMD-probed control bytes (Swiss-table style) for point lookups.
+ *
+ * Provides function definitions for HashIndex.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include "search.h"
+#include "sort_stats.h"
+
+// SSE2 is part of x86-64, so the group compare needs no runtime dispatch.
+#if defined(__SSE2__)
+#define HASH_SSE2 1
+#include <emmintrin.h>
+#else
+#define HASH_SSE2 0
+#endif
+
+// ====== Hash Index ======
+int buildHashIndex(const int[], const int, HashIndex*);
+void freeHashIndex(HashIndex*);
+int hashSearch(const int, const HashIndex*);
+static uint64_t hashKey(const int);
+static unsigned matchGroup(const unsigned char[], const unsigned char);
+static void* allocateAligned(const size_t);
+
+// Slots per group: 16 control bytes fill one SSE2 register & 16 keys one cache line.
+static const int HASH_GROUP_SLOTS = 16;
+// Most slots of a group filled on average: the table is sized for a load factor of at most 7/8.
+static const int HASH_GROUP_LOAD = HASH_GROUP_SLOTS * 7 / 8;
+// Control byte of an empty slot. A full slot's byte is 7 bits of hash, so its top bit is clear.
+static const unsigned char HASH_EMPTY = 0x80;
+// Elements ahead of the one being inserted whose groups buildHashIndex prefetches.
+static const int HASH_PREFETCH_DISTANCE = 16;
+// Alignment of the control bytes & the keys, so that a group never straddles two cache lines.
+static const size_t HASH_ALIGNMENT = 64;
+
+
+/**
+ * @brief Mixes the bits of a key (the murmur3 finalizer), so that sequential & strided keys spread over the groups.
+ *
+ * The low 7 bits become the control byte & the bits above them pick the first group.
+ */
+static uint64_t hashKey(const int value) {
+    uint64_t h = (uint32_t)value;
+
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+/**
+ * @brief Returns a bit mask of the slots of a group whose control byte equals @p byte.
+ *
+ * @param control The group's 16 control bytes, 16-byte aligned.
+ * @param byte Control byte to look for.
+ */
+static unsigned matchGroup(const unsigned char control[], const unsigned char byte) {
+#if HASH_SSE2
+    __m128i group = _mm_load_si128((const __m128i*)control);
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8((char)byte)));
+#else
+    unsigned mask = 0;
+    for (int i = 0; i < HASH_GROUP_SLOTS; i++) {
+        mask |= (unsigned)(control[i] == byte) << i;
+    }
+    return mask;
+#endif
+}
+
+/**
+ * @brief Allocates a cache-line aligned buffer of @p bytes bytes.
+ *
+ * @return Pointer to the buffer; nullptr, if it could not be allocated.
+ */
+static void* allocateAligned(const size_t bytes) {
+    return std::aligned_alloc(HASH_ALIGNMENT, (bytes + HASH_ALIGNMENT - 1) / HASH_ALIGNMENT * HASH_ALIGNMENT);
+}
+
+/**
+ * @brief Builds a hash index of an unsorted array, mapping each distinct value to the index of its first occurrence.
+ *
+ * O(n) expected & no sort: where sorting an array to binary search it once costs more
+ * than the search, the index answers point lookups with the same results as linearSearch
+ * in O(1). The groups of the next elements are prefetched while one is inserted, so the
+ * cache misses of a table larger than the cache overlap. @p arr is not referenced afterwards.
+ *
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param index Pointer to the index to fill. Release it with freeHashIndex.
+ *
+ * @return 0, if the index was built.
+ * @return -2, if @p arr or @p index is null or if @p length is a non-positive integer.
+ * @return -4, if memory for the index could not be allocated.
+ *
+ * @code
+ * int arr[] = {5, 3, 1, 3, 2};
+ * HashIndex index;
+ *
+ * buildHashIndex(arr, 5, &index);
+ * hashSearch(3, &index); // Returns 1
+ * freeHashIndex(&index);
+ * @endcode
+ */
+int buildHashIndex(const int arr[], const int length, HashIndex* index) {
+    if (arr == NULL || index == NULL) {
+        return -2;
+    }
+    if (length <= 0) {
+        return -2;
+    }
+
+    size_t groups = 1;
+    while (groups * HASH_GROUP_LOAD < (size_t)length) {
+        groups *= 2;
+    }
+    const size_t slots = groups * HASH_GROUP_SLOTS;
+
+    index->control = (unsigned char*)allocateAligned(slots);
+    index->keys = (int*)allocateAligned(slots * sizeof(int));
+    index->ranks = (int*)allocateAligned(slots * sizeof(int));
+    index->groups = (int)groups;
+    index->length = length;
+
+    if (!index->control || !index->keys || !index->ranks) {
+        freeHashIndex(index);
+        return -4;
+    }
+
+    std::memset(index->control, HASH_EMPTY, slots);
+
+    const size_t group_mask = groups - 1;
+
+    for (int i = 0; i < length; i++) {
+        if (i + HASH_PREFETCH_DISTANCE < length) {
+            size_t ahead = (hashKey(arr[i + HASH_PREFETCH_DISTANCE]) >> 7) & group_mask;
+            __builtin_prefetch(index->control + ahead*HASH_GROUP_SLOTS, 1);
+            __builtin_prefetch(index->keys + ahead*HASH_GROUP_SLOTS, 1);
+        }
+
+        const uint64_t h = hashKey(arr[i]);
+        const unsigned char tag = h & 0x7F;
+        size_t group = (h >> 7) & group_mask;
+
+        // Triangular steps over a power-of-two number of groups visit every group.
+        for (size_t step = 1; ; step++) {
+            unsigned char* control = index->control + group*HASH_GROUP_SLOTS;
+            unsigned hits = matchGroup(control, tag);
+            bool seen = false;
+
+            while (hits && !seen) {
+                seen = index->keys[group*HASH_GROUP_SLOTS + __builtin_ctz(hits)] == arr[i];
+                hits &= hits - 1;
+            }
+            // A later duplicate keeps the first occurrence's index.
+            if (seen) {
+                break;
+            }
+
+            unsigned empty = matchGroup(control, HASH_EMPTY);
+            if (empty) {
+                size_t slot = group*HASH_GROUP_SLOTS + __builtin_ctz(empty);
+                index->control[slot] = tag;
+                index->keys[slot] = arr[i];
+                index->ranks[slot] = i;
+                break;
+            }
+
+            group = (group + step) & group_mask;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Releases the memory held by a hash index.
+ *
+ * @param index Pointer to the index. Null pointers are ignored.
+ */
+void freeHashIndex(HashIndex* index) {
+    if (!index) {
+        return;
+    }
+
+    std::free(index->control);
+    std::free(index->keys);
+    std::free(index->ranks);
+    index->control = nullptr;
+    index->keys = nullptr;
+    index->ranks = nullptr;
+    index->groups = 0;
+    index->length = 0;
+}
+
+/**
+ * @brief Returns the index of the first occurrence of an element in the original array using a hash index.
+ *
+ * Compares the key's 7-bit tag with a group's 16 control bytes at once & the key itself
+ * only with the matching slots: a stray tag matches 1 slot in 128, so there is rarely a
+ * wasted key compare. A group with an empty slot ends the probe, so most lookups read
+ * one group: its control bytes & one cache line of keys.
+ *
+ * @param value Number to be searched in the array.
+ * @param index Pointer to an index built by buildHashIndex.
+ *
+ * @return Index of the first occurrence of @p value in the original array, like linearSearch, if found; otherwise, -1.
+ * @return -2, if @p index is null or empty.
+ *
+ * @code
+ * int arr[] = {5, 3, 1, 3, 2};
+ * HashIndex index;
+ * buildHashIndex(arr, 5, &index);
+ *
+ * hashSearch(3, &index); // Returns 1
+ * hashSearch(4, &index); // Returns -1
+ * @endcode
+ */
+int hashSearch(const int value, const HashIndex* index) {
+    if (index == NULL || index->control == NULL) {
+        return -2;
+    }
+    if (index->length <= 0) {
+        return -2;
+    }
+
+    const uint64_t h = hashKey(value);
+    const unsigned char tag = h & 0x7F;
+    const size_t group_mask = (size_t)index->groups - 1;
+    size_t group = (h >> 7) & group_mask;
+
+    for (size_t step = 1; ; step++) {
+        const unsigned char* control = index->control + group*HASH_GROUP_SLOTS;
+        unsigned hits = matchGroup(control, tag);
+
+        while (hits) {
+            size_t slot = group*HASH_GROUP_SLOTS + __builtin_ctz(hits);
+            countComparisons(1);
+            if (index->keys[slot] == value) {
+                return index->ranks[slot];
+            }
+            hits &= hits - 1;
+        }
+
+        if (matchGroup(control, HASH_EMPTY)) {
+            return -1;
+        }
+
+        group = (group + step) & group_mask;
+    }
+}
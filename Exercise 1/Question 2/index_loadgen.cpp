@@ -0,0 +1,285 @@
+/**
+ * @file index_loadgen.cpp
+ * @brief Program to measure the latency & throughput of index_server - Closed-loop clients over a Unix-domain socket.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "bench_util.h"
+#include "index_protocol.h"
+#include "io.h"
+#include "sort_templates.h"
+
+using std::cerr;
+using std::endl;
+
+/**
+ * @brief What one client thread does & measures.
+ */
+struct ClientResult {
+    std::vector<double> latencies_ns;   // Round trip of each request.
+    long long misses;                   // Queries the server answered with -1 (or, for ranges, an empty range).
+    bool failed;
+};
+
+// ====== Load Generator ======
+int runLoadGenerator(int, char*[]);
+static int connectToServer(const char*);
+static bool sendAll(const int, const void*, size_t);
+static bool receiveAll(const int, void*, size_t);
+static void runClient(const char*, const uint32_t, const int, const int, const uint64_t, ClientResult*);
+static double percentile(std::vector<double>&, const double);
+
+static const char* const LOADGEN_OPTIONS[] = {"socket", "op", "connections", "requests", "batch", nullptr};
+
+
+/*
+Usage:
+    index_loadgen [--socket=PATH] [--op=binary|linear|range] [--connections=C] [--requests=N] [--batch=B]
+*/
+int main(int argc, char* argv[]) {
+    return runLoadGenerator(argc, argv);
+}
+
+/**
+ * @brief Runs closed-loop clients against index_server & prints the request latency percentiles & throughput.
+ *
+ * Each of the --connections clients (default 4) has its own thread & connection, asks
+ * the server for the dataset's minimum & maximum, then sends --requests requests (default
+ * 10000) of --batch random queries each (default 16), one at a time, timing each round
+ * trip. Queries are uniform between the minimum & maximum, so on sparse data most of
+ * them miss, which costs a binary search as much as a hit. Prints one line of key=value
+ * pairs to stdout.
+ *
+ * @param argc, argv Arguments passed to main.
+ *
+ * @return 0, if every request was answered; otherwise, 1 after printing an error to stderr.
+ *
+ * @code
+ * // ./index_loadgen --op=binary --connections=8 --batch=64
+ * // requests=80000 queries=5120000 seconds=1.92 queries_per_s=2666666 p50_us=21.4 p99_us=88.0 p999_us=190.3 max_us=1210.9 misses=5081344
+ * @endcode
+ */
+int runLoadGenerator(int argc, char* argv[]) {
+    const char* unknown = findUnknownOption(argc, argv, LOADGEN_OPTIONS);
+    const char* socket_option = getOption(argc, argv, "socket");
+    const char* op_name = getOption(argc, argv, "op");
+    const char* connections = getOption(argc, argv, "connections");
+    const char* requests = getOption(argc, argv, "requests");
+    const char* batch = getOption(argc, argv, "batch");
+
+    const char* socket_path = socket_option ? socket_option : INDEX_DEFAULT_SOCKET;
+    const int num_clients = connections ? std::atoi(connections) : 4;
+    const int num_requests = requests ? std::atoi(requests) : 10000;
+    const int batch_size = batch ? std::atoi(batch) : 16;
+
+    uint32_t op = 0;
+    if (!op_name || std::strcmp(op_name, "binary") == 0) {
+        op = INDEX_OP_BINARY;
+    }
+    else if (std::strcmp(op_name, "linear") == 0) {
+        op = INDEX_OP_LINEAR;
+    }
+    else if (std::strcmp(op_name, "range") == 0) {
+        op = INDEX_OP_RANGE;
+    }
+
+    if (unknown) {
+        cerr << "Error: Unknown option " << unknown << "." << endl;
+        return 1;
+    }
+    if (op == 0 || num_clients <= 0 || num_requests <= 0 || batch_size <= 0 || (uint32_t)batch_size > INDEX_MAX_QUERIES) {
+        cerr << "Usage: " << argv[0] << " [--socket=PATH] [--op=binary|linear|range] [--connections=C] [--requests=N] [--batch=B]" << endl;
+        cerr << "B: 1 to " << INDEX_MAX_QUERIES << endl;
+        return 1;
+    }
+
+    std::vector<ClientResult> results(num_clients);
+    std::vector<std::thread> clients;
+
+    double start_ns = nowNs();
+    for (int i = 0; i < num_clients; i++) {
+        clients.emplace_back(runClient, socket_path, op, num_requests, batch_size, (uint64_t)i + 1, &results[i]);
+    }
+    for (std::thread& client : clients) {
+        client.join();
+    }
+    double seconds = (nowNs() - start_ns) / 1e9;
+
+    std::vector<double> latencies;
+    long long misses = 0;
+
+    for (const ClientResult& result : results) {
+        if (result.failed) {
+            cerr << "Error: Could not talk to the server on " << socket_path << "." << endl;
+            return 1;
+        }
+        latencies.insert(latencies.end(), result.latencies_ns.begin(), result.latencies_ns.end());
+        misses += result.misses;
+    }
+
+    long long total_queries = (long long)latencies.size() * batch_size;
+
+    std::printf("requests=%zu queries=%lld seconds=%.2f queries_per_s=%.0f p50_us=%.1f p99_us=%.1f p999_us=%.1f max_us=%.1f misses=%lld\n",
+                latencies.size(), total_queries, seconds, total_queries / seconds,
+                percentile(latencies, 0.5) / 1e3, percentile(latencies, 0.99) / 1e3,
+                percentile(latencies, 0.999) / 1e3, percentile(latencies, 1.0) / 1e3, misses);
+    return 0;
+}
+
+/**
+ * @brief Connects a blocking Unix-domain stream socket to @p path.
+ *
+ * @return File descriptor of the socket; -1, if the connection failed.
+ */
+static int connectToServer(const char* path) {
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (std::strlen(path) >= sizeof(address.sun_path)) {
+        return -1;
+    }
+    std::strcpy(address.sun_path, path);
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (connect(fd, (sockaddr*)&address, sizeof(address)) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+/**
+ * @brief Sends @p bytes bytes, retrying partial sends.
+ *
+ * @return True, if everything was sent; false, if the connection failed.
+ */
+static bool sendAll(const int fd, const void* data, size_t bytes) {
+    const char* p = static_cast<const char*>(data);
+
+    while (bytes > 0) {
+        ssize_t sent = send(fd, p, bytes, MSG_NOSIGNAL);
+        if (sent < 0 && errno == EINTR) {
+            continue;
+        }
+        if (sent <= 0) {
+            return false;
+        }
+        p += sent;
+        bytes -= sent;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Receives exactly @p bytes bytes, retrying partial receives.
+ *
+ * @return True, if everything was received; false, if the connection closed or failed first.
+ */
+static bool receiveAll(const int fd, void* data, size_t bytes) {
+    char* p = static_cast<char*>(data);
+
+    while (bytes > 0) {
+        ssize_t received = recv(fd, p, bytes, 0);
+        if (received < 0 && errno == EINTR) {
+            continue;
+        }
+        if (received <= 0) {
+            return false;
+        }
+        p += received;
+        bytes -= received;
+    }
+
+    return true;
+}
+
+/**
+ * @brief One closed-loop client: asks for the dataset's range, then times @p num_requests requests of @p batch_size queries.
+ */
+static void runClient(const char* socket_path, const uint32_t op, const int num_requests, const int batch_size,
+                      const uint64_t seed, ClientResult* result) {
+    result->misses = 0;
+    result->failed = true;
+
+    int fd = connectToServer(socket_path);
+    if (fd < 0) {
+        return;
+    }
+
+    IndexRequestHeader info_request = {INDEX_OP_INFO, 0};
+    IndexResponseHeader response;
+    int info[3];
+
+    if (!sendAll(fd, &info_request, sizeof(info_request)) || !receiveAll(fd, &response, sizeof(response))
+        || response.status != 0 || response.count != 3 || !receiveAll(fd, info, sizeof(info))) {
+        close(fd);
+        return;
+    }
+
+    const uint64_t span = (uint64_t)((long long)info[2] - info[1]) + 1;
+    const uint32_t num_values = indexFrameValues(op, batch_size);
+    std::vector<char> request(sizeof(IndexRequestHeader) + num_values * sizeof(int));
+    std::vector<int> answers(num_values);
+    uint64_t state = seed * 0x9E3779B97F4A7C15ULL;
+
+    IndexRequestHeader header = {op, (uint32_t)batch_size};
+    std::memcpy(request.data(), &header, sizeof(header));
+    int* queries = reinterpret_cast<int*>(request.data() + sizeof(header));
+
+    result->latencies_ns.reserve(num_requests);
+
+    for (int r = 0; r < num_requests; r++) {
+        for (uint32_t i = 0; i < num_values; i++) {
+            queries[i] = (int)(info[1] + (long long)(nextRandom(&state) % span));
+        }
+        // A range covers 1/1024 of the data's span from its random low end.
+        for (uint32_t i = 0; op == INDEX_OP_RANGE && i < num_values; i += 2) {
+            queries[i + 1] = (int)std::min<long long>((long long)queries[i] + (long long)(span >> 10), info[2]);
+        }
+
+        double start_ns = nowNs();
+        if (!sendAll(fd, request.data(), request.size()) || !receiveAll(fd, &response, sizeof(response))
+            || response.status != 0 || !receiveAll(fd, answers.data(), answers.size() * sizeof(int))) {
+            close(fd);
+            return;
+        }
+        result->latencies_ns.push_back(nowNs() - start_ns);
+
+        for (uint32_t i = 0; i < num_values; i += (op == INDEX_OP_RANGE ? 2 : 1)) {
+            bool miss = op == INDEX_OP_RANGE ? answers[i + 1] == 0 : answers[i] < 0;
+            result->misses += miss;
+        }
+    }
+
+    close(fd);
+    result->failed = false;
+}
+
+/**
+ * @brief Returns the @p q quantile of @p values, reordering them with nthElement in O(n).
+ */
+static double percentile(std::vector<double>& values, const double q) {
+    if (values.empty()) {
+        return 0;
+    }
+
+    size_t idx = std::min(values.size() - 1, (size_t)(q * values.size()));
+    nthElement(values.begin(), values.begin() + idx, values.end());
+    return values[idx];
+}
@@ -0,0 +1,60 @@
+/**
+ * @file index_protocol.h
+ * @brief Index server protocol - Binary frames exchanged by index_server & its clients over a Unix-domain socket.
+ *
+ * A client sends requests & reads responses on one stream connection, & may pipeline
+ * any number of requests; responses come back in request order. Every frame is a
+ * fixed 8-byte header followed by packed int32 values, all in the host's byte order
+ * (the socket is local, so both ends share it).
+ *
+ *   Request:  IndexRequestHeader{op, count}, then count values (2 * count for INDEX_OP_RANGE).
+ *   Response: IndexResponseHeader{status, count}, then count values (2 * count for INDEX_OP_RANGE).
+ *
+ * INDEX_OP_LINEAR   Each value: its index in the dataset as loaded, like linearSearch; -1 if absent.
+ * INDEX_OP_BINARY   Each value: the index of its first occurrence in the sorted dataset, like binarySearch; -1 if absent.
+ * INDEX_OP_RANGE    Each pair lo, hi: the index in the sorted dataset of the first element >= lo,
+ *                   & the number of elements in [lo, hi].
+ * INDEX_OP_INFO     No values; the response holds 3: the dataset's length, minimum & maximum.
+ *
+ * A malformed request (unknown op, or count above INDEX_MAX_QUERIES) gets a response with
+ * status -2 & count 0, after which the server closes the connection.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#pragma once
+
+#include <cstdint>
+
+// Socket path used when --socket is not given.
+static const char* const INDEX_DEFAULT_SOCKET = "/tmp/dsa_index.sock";
+// Most values (pairs, for INDEX_OP_RANGE) one request may carry: 256 KiB of queries (512 KiB for ranges).
+static const uint32_t INDEX_MAX_QUERIES = 1 << 16;
+
+enum IndexOp : uint32_t {
+    INDEX_OP_LINEAR = 1,
+    INDEX_OP_BINARY = 2,
+    INDEX_OP_RANGE = 3,
+    INDEX_OP_INFO = 4
+};
+
+struct IndexRequestHeader {
+    uint32_t op;
+    uint32_t count;
+};
+
+struct IndexResponseHeader {
+    int32_t status;
+    uint32_t count;
+};
+
+static_assert(sizeof(IndexRequestHeader) == 8, "Index frames start with an 8-byte header");
+static_assert(sizeof(IndexResponseHeader) == 8, "Index frames start with an 8-byte header");
+
+/**
+ * @brief Returns the number of int32 values that follow a request or response header of @p op with @p count.
+ */
+static inline uint32_t indexFrameValues(const uint32_t op, const uint32_t count) {
+    return op == INDEX_OP_RANGE ? 2 * count : count;
+}
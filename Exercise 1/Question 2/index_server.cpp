@@ -0,0 +1,518 @@
+/**
+ * @file index_server.cpp
+ * @brief Program to serve searches over a dataset loaded & sorted once - Linear, Binary & Range queries over a Unix-domain socket.
+ *
+ * The protocol is described in index_protocol.h.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "array_file.h"
+#include "index_protocol.h"
+#include "io.h"
+#include "search.h"
+#include "sort.h"
+
+using std::cerr;
+using std::endl;
+
+/**
+ * @brief The dataset in both orders: as loaded, for linear queries, & sorted, for binary & range queries.
+ */
+struct IndexDataset {
+    MappedArray original;
+    int* sorted_copy;       // new[] copy sorted by the server; null if the file was already sorted.
+    SortedView view;
+};
+
+/**
+ * @brief A client connection. Bytes are buffered in both directions so no call ever blocks.
+ */
+struct Connection {
+    int fd;
+    uint32_t events;        // Events the connection is registered for.
+    bool closing;           // Close once the output is flushed: the client hung up or sent a malformed request.
+    std::vector<char> in;   // Received bytes not yet parsed; at most one partial frame between rounds.
+    std::vector<char> out;  // Responses not yet sent.
+    size_t out_sent;
+};
+
+/**
+ * @brief A parsed request waiting for its response. Its values were copied out of the connection's input.
+ */
+struct PendingRequest {
+    Connection* conn;
+    uint32_t op;
+    uint32_t count;
+    size_t offset;          // Of the values in the round's binary queries (INDEX_OP_BINARY) or other values.
+    bool valid;
+};
+
+// ====== Server ======
+int runIndexServer(int, char*[]);
+static int loadDataset(const char*, IndexDataset*);
+static void freeDataset(IndexDataset*);
+static int openListener(const char*);
+static int removeStaleSocket(const sockaddr_un&);
+static void acceptConnections(const int, const int);
+static bool readAvailable(Connection*);
+static void parseRequests(Connection*, std::vector<PendingRequest>&, std::vector<int>&, std::vector<int>&);
+static void answerRequest(const PendingRequest&, const IndexDataset&, const std::vector<int>&, const std::vector<int>&);
+static bool flushOutput(Connection*);
+static void watch(const int, Connection*, const uint32_t);
+
+static const char* const SERVER_OPTIONS[] = {"input", "socket", nullptr};
+
+// Most events one epoll_wait returns; more ready connections are picked up in the next round.
+static const int MAX_EVENTS = 256;
+// Most bytes read from one connection per round, so one busy client cannot starve the others.
+static const size_t MAX_READ_PER_ROUND = 1 << 20;
+static const size_t READ_CHUNK_BYTES = 64 << 10;
+
+// Set by SIGINT & SIGTERM; the event loop exits & removes the socket.
+static volatile sig_atomic_t stop_requested = 0;
+
+
+/*
+Usage:
+    index_server --input=FILE [--socket=PATH]
+                 FILE: whitespace-separated integers, or an array file (see array_file.h)
+*/
+int main(int argc, char* argv[]) {
+    return runIndexServer(argc, argv);
+}
+
+/**
+ * @brief Loads & sorts a dataset once, then answers queries on a Unix-domain socket until SIGINT or SIGTERM.
+ *
+ * A single thread runs an epoll event loop over non-blocking sockets. Each round reads
+ * every ready connection, parses all the complete requests, answers all their binary
+ * queries with one binarySearchBatch call (sorted, so queries from different clients
+ * share cache lines) & writes the responses. A connection whose responses are not
+ * fully sent is not read from until they are, so a client that stops reading cannot
+ * make the server buffer without bound.
+ *
+ * @param argc, argv Arguments passed to main.
+ *
+ * @return 0, after a clean shutdown; otherwise, 1 after printing an error to stderr.
+ *
+ * @code
+ * // ./index_server --input=data.bin --socket=/tmp/dsa_index.sock &
+ * // ./index_loadgen --socket=/tmp/dsa_index.sock --op=binary --batch=64
+ * @endcode
+ */
+int runIndexServer(int argc, char* argv[]) {
+    const char* unknown = findUnknownOption(argc, argv, SERVER_OPTIONS);
+    const char* input = getOption(argc, argv, "input");
+    const char* socket_option = getOption(argc, argv, "socket");
+    const char* socket_path = socket_option ? socket_option : INDEX_DEFAULT_SOCKET;
+
+    if (unknown) {
+        cerr << "Error: Unknown option " << unknown << "." << endl;
+        return 1;
+    }
+    if (!input) {
+        cerr << "Usage: " << argv[0] << " --input=FILE [--socket=PATH]" << endl;
+        return 1;
+    }
+
+    IndexDataset dataset;
+    if (loadDataset(input, &dataset) != 0) {
+        cerr << "Error: Could not load integers from " << input << "." << endl;
+        return 1;
+    }
+
+    int listen_fd = openListener(socket_path);
+    if (listen_fd < 0) {
+        if (listen_fd == -2) {
+            cerr << "Error: Another server is listening on " << socket_path << "." << endl;
+        } else if (listen_fd == -3) {
+            cerr << "Error: " << socket_path << " exists & is not a socket." << endl;
+        } else {
+            cerr << "Error: Could not listen on " << socket_path << "." << endl;
+        }
+        freeDataset(&dataset);
+        return 1;
+    }
+
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event listen_event = {};
+    listen_event.events = EPOLLIN;
+    listen_event.data.ptr = nullptr;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &listen_event);
+
+    struct sigaction action = {};
+    action.sa_handler = [](int) { stop_requested = 1; };
+    sigaction(SIGINT, &action, nullptr);
+    sigaction(SIGTERM, &action, nullptr);
+
+    cerr << "Serving " << dataset.view.length() << " integers on " << socket_path << "." << endl;
+
+    epoll_event events[MAX_EVENTS];
+    std::vector<PendingRequest> pending;
+    std::vector<int> binary_queries, binary_results, values;
+    std::vector<Connection*> touched;
+
+    while (!stop_requested) {
+        int num_events = epoll_wait(epoll_fd, events, MAX_EVENTS, -1);
+        if (num_events < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            cerr << "Error: epoll_wait failed." << endl;
+            break;
+        }
+
+        pending.clear();
+        binary_queries.clear();
+        values.clear();
+        touched.clear();
+
+        for (int i = 0; i < num_events; i++) {
+            Connection* conn = static_cast<Connection*>(events[i].data.ptr);
+
+            if (!conn) {
+                acceptConnections(epoll_fd, listen_fd);
+                continue;
+            }
+
+            if ((events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) && !readAvailable(conn)) {
+                conn->closing = true;
+            }
+            parseRequests(conn, pending, binary_queries, values);
+            touched.push_back(conn);
+        }
+
+        // One batch for every binary query of the round, from every client; interleaved on datasets larger than L2.
+        binary_results.resize(binary_queries.size());
+        if (!binary_queries.empty()) {
+            binarySearchBatch(binary_queries.data(), (int)binary_queries.size(), dataset.view, binary_results.data(), true);
+        }
+
+        for (const PendingRequest& request : pending) {
+            answerRequest(request, dataset, binary_results, values);
+        }
+
+        for (Connection* conn : touched) {
+            bool flushed = flushOutput(conn);
+
+            if (flushed && conn->closing) {
+                close(conn->fd); // Also removes it from the epoll set.
+                delete conn;
+            }
+            else {
+                // Stop reading until the responses are out.
+                watch(epoll_fd, conn, flushed ? EPOLLIN : EPOLLOUT);
+            }
+        }
+    }
+
+    close(epoll_fd);
+    close(listen_fd);
+    unlink(socket_path);
+    freeDataset(&dataset);
+    cerr << "Stopped." << endl;
+    return 0;
+}
+
+/**
+ * @brief Loads the dataset & sorts a copy of it, unless the array file's sorted flag says it already is.
+ *
+ * @return 0, if the dataset is ready; otherwise, the error of loadIntegerArray, or -4 if it is empty or the copy failed.
+ */
+static int loadDataset(const char* input, IndexDataset* dataset) {
+    dataset->sorted_copy = nullptr;
+
+    int status = loadIntegerArray(input, ARRAY_FILE_READ, &dataset->original);
+    if (status != 0) {
+        return status;
+    }
+    if (dataset->original.length == 0) {
+        closeArrayFile(&dataset->original);
+        return -4;
+    }
+
+    if (viewArrayFile(&dataset->original, &dataset->view) == 0) {
+        return 0;
+    }
+
+    dataset->sorted_copy = deepCopyArray(dataset->original.data, dataset->original.length);
+    if (!dataset->sorted_copy) {
+        closeArrayFile(&dataset->original);
+        return -4;
+    }
+
+    dataset->view = sortToView(dataset->sorted_copy, dataset->original.length,
+                               [](int arr[], const int length, bool desc) { radixSort(arr, length, desc); });
+    return 0;
+}
+
+/**
+ * @brief Releases the dataset's file or buffer & its sorted copy.
+ */
+static void freeDataset(IndexDataset* dataset) {
+    closeArrayFile(&dataset->original);
+    delete[] dataset->sorted_copy;
+}
+
+/**
+ * @brief Removes the socket file a server that is no longer running left at an address.
+ *
+ * A socket file outlives its server if the server was killed. It is stale if nothing
+ * accepts connections on it any more; any other file, or a live socket, is left alone.
+ *
+ * @return 0, if nothing exists at the path or a stale socket was removed.
+ * @return -1, if the path could not be checked or removed.
+ * @return -2, if a server is listening on the socket.
+ * @return -3, if the path exists but is not a socket.
+ */
+static int removeStaleSocket(const sockaddr_un& address) {
+    struct stat info;
+    if (lstat(address.sun_path, &info) != 0) {
+        return errno == ENOENT ? 0 : -1;
+    }
+    if (!S_ISSOCK(info.st_mode)) {
+        return -3;
+    }
+
+    int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (probe < 0) {
+        return -1;
+    }
+
+    bool listening = connect(probe, (const sockaddr*)&address, sizeof(address)) == 0;
+    bool stale = !listening && errno == ECONNREFUSED;
+    close(probe);
+
+    if (listening) {
+        return -2;
+    }
+    if (!stale || unlink(address.sun_path) != 0) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Creates a non-blocking Unix-domain stream socket listening on @p path, replacing a stale socket file.
+ *
+ * @return File descriptor of the socket; -1, if it could not be created, bound or put to listen.
+ * @return -2, if another server is listening on @p path; -3, if @p path exists but is not a socket.
+ */
+static int openListener(const char* path) {
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (std::strlen(path) >= sizeof(address.sun_path)) {
+        return -1;
+    }
+    std::strcpy(address.sun_path, path);
+
+    int status = removeStaleSocket(address);
+    if (status != 0) {
+        return status;
+    }
+
+    int fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+
+    if (bind(fd, (sockaddr*)&address, sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0) {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+/**
+ * @brief Accepts every pending connection & registers it for input.
+ */
+static void acceptConnections(const int epoll_fd, const int listen_fd) {
+    while (true) {
+        int fd = accept4(listen_fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            return; // EAGAIN once the backlog is empty; other errors are retried on the next event.
+        }
+
+        Connection* conn = new Connection{fd, 0, false, {}, {}, 0};
+        watch(epoll_fd, conn, EPOLLIN);
+    }
+}
+
+/**
+ * @brief Appends the bytes available on a connection to its input, up to MAX_READ_PER_ROUND.
+ *
+ * @return False, if the client closed the connection or it failed; otherwise, true.
+ */
+static bool readAvailable(Connection* conn) {
+    size_t read_total = 0;
+
+    while (read_total < MAX_READ_PER_ROUND) {
+        size_t used = conn->in.size();
+        conn->in.resize(used + READ_CHUNK_BYTES);
+
+        ssize_t read_bytes = recv(conn->fd, conn->in.data() + used, READ_CHUNK_BYTES, 0);
+        conn->in.resize(used + (read_bytes > 0 ? read_bytes : 0));
+
+        if (read_bytes == 0) {
+            return false;
+        }
+        if (read_bytes < 0) {
+            return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+        }
+
+        read_total += read_bytes;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Moves every complete request out of a connection's input into the round's pending requests.
+ *
+ * Binary queries go to @p binary_queries, to be searched as one batch; the values of other
+ * requests go to @p values. Requests that arrived before the client hung up are still parsed.
+ * A malformed request is queued as invalid & drops the rest of the input: the connection
+ * is answered & closed.
+ */
+static void parseRequests(Connection* conn, std::vector<PendingRequest>& pending,
+                          std::vector<int>& binary_queries, std::vector<int>& values) {
+    size_t offset = 0;
+
+    while (conn->in.size() - offset >= sizeof(IndexRequestHeader)) {
+        IndexRequestHeader header;
+        std::memcpy(&header, conn->in.data() + offset, sizeof(header));
+
+        if (header.op < INDEX_OP_LINEAR || header.op > INDEX_OP_INFO || header.count > INDEX_MAX_QUERIES) {
+            pending.push_back({conn, header.op, 0, 0, false});
+            conn->closing = true;
+            conn->in.clear();
+            return;
+        }
+
+        size_t num_values = header.op == INDEX_OP_INFO ? 0 : indexFrameValues(header.op, header.count);
+        size_t frame_bytes = sizeof(header) + num_values * sizeof(int);
+        if (conn->in.size() - offset < frame_bytes) {
+            break;
+        }
+
+        std::vector<int>& destination = header.op == INDEX_OP_BINARY ? binary_queries : values;
+        size_t start = destination.size();
+
+        destination.resize(start + num_values);
+        std::memcpy(destination.data() + start, conn->in.data() + offset + sizeof(header), num_values * sizeof(int));
+
+        pending.push_back({conn, header.op, header.count, start, true});
+        offset += frame_bytes;
+    }
+
+    conn->in.erase(conn->in.begin(), conn->in.begin() + offset);
+}
+
+/**
+ * @brief Appends the response to a request to its connection's output.
+ */
+static void answerRequest(const PendingRequest& request, const IndexDataset& dataset, const std::vector<int>& binary_results,
+                          const std::vector<int>& values) {
+    std::vector<char>& out = request.conn->out;
+    IndexResponseHeader header = {0, request.count};
+
+    if (!request.valid) {
+        header = {-2, 0};
+        out.insert(out.end(), (const char*)&header, (const char*)&header + sizeof(header));
+        return;
+    }
+
+    const int* sorted = dataset.view.data();
+    const int length = dataset.view.length();
+    std::vector<int> results;
+
+    switch (request.op) {
+        case INDEX_OP_LINEAR:
+            results.resize(request.count);
+            for (uint32_t i = 0; i < request.count; i++) {
+                results[i] = linearSearch(values[request.offset + i], dataset.original.data, dataset.original.length);
+            }
+            break;
+
+        case INDEX_OP_BINARY:
+            results.assign(binary_results.begin() + request.offset, binary_results.begin() + request.offset + request.count);
+            break;
+
+        case INDEX_OP_RANGE:
+            results.resize(2 * request.count);
+            for (uint32_t i = 0; i < request.count; i++) {
+                int lo = values[request.offset + 2*i];
+                int hi = values[request.offset + 2*i + 1];
+
+                results[2*i] = lowerBound(lo, dataset.view);
+                results[2*i + 1] = countInRange(lo, hi, dataset.view);
+            }
+            break;
+
+        case INDEX_OP_INFO:
+            results = {length, sorted[0], sorted[length - 1]};
+            header.count = 3;
+            break;
+    }
+
+    out.insert(out.end(), (const char*)&header, (const char*)&header + sizeof(header));
+    out.insert(out.end(), (const char*)results.data(), (const char*)(results.data() + results.size()));
+}
+
+/**
+ * @brief Sends as much of a connection's output as the socket takes without blocking.
+ *
+ * @return True, if the output is empty afterwards, or the connection failed & should be closed; otherwise, false.
+ */
+static bool flushOutput(Connection* conn) {
+    while (conn->out_sent < conn->out.size()) {
+        ssize_t sent = send(conn->fd, conn->out.data() + conn->out_sent, conn->out.size() - conn->out_sent, MSG_NOSIGNAL);
+
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                return false;
+            }
+            conn->closing = true;
+            break;
+        }
+
+        conn->out_sent += sent;
+    }
+
+    conn->out.clear();
+    conn->out_sent = 0;
+    return true;
+}
+
+/**
+ * @brief Registers a connection for @p events, or updates its registration if they changed.
+ */
+static void watch(const int epoll_fd, Connection* conn, const uint32_t events) {
+    if (conn->events == events) {
+        return;
+    }
+
+    epoll_event event = {};
+    event.events = events;
+    event.data.ptr = conn;
+    epoll_ctl(epoll_fd, conn->events == 0 ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, conn->fd, &event);
+    conn->events = events;
+}
@@ -0,0 +1,667 @@
+/**
+ * @file io.cpp
+ * @brief Input & output utilities - Interactive prompts, Bulk integer files, Command-line options.
+ * 
+ * Provides function definitions for the utilities declared in io.h.
+ * 
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <new>
+#include <fcntl.h>
+#include <unistd.h>
+#include "io.h"
+
+using std::cin;
+using std::cout;
+using std::endl;
+
+using std::numeric_limits; using std::streamsize; // For handling input exceptions
+using std::bad_alloc;
+
+// ====== Utilities ======
+bool isInvalidInput();
+
+// ====== Array Utilities ======
+int getArrayLengthInput();
+int* getArrayInput(const int);
+int* deepCopyArray(const int[], const int);
+void copyArray(int[], const int[], const int);
+
+// ====== Input Utilities ======
+int getIntegerInput();
+
+// ====== Printing Utilities ======
+void printArray(const int[], const int);
+
+// ====== Bulk File Utilities ======
+int readIntegerFile(const char*, int**, int*);
+int streamIntegerFile(const char*, int (*consume)(const int[], const int, void*), void*);
+int writeIntegerFile(const char*, const int[], const int);
+
+// ====== Command-line Utilities ======
+const char* getOption(int, char*[], const char*);
+bool hasFlag(int, char*[], const char*);
+const char* findUnknownOption(int, char*[], const char* const[]);
+
+// Size of the buffer bulk reads & writes go through.
+static const size_t IO_BUFFER_BYTES = 1 << 22;
+// Longest integer token: "-2147483648".
+static const size_t MAX_INT_CHARS = 11;
+// Most integers streamIntegerFile hands to its consumer at once.
+static const int STREAM_BATCH_INTS = 1 << 14;
+
+
+/**
+ * @brief Checks whether the previous input was invalid.
+ * 
+ * @return True, if the input is invalid; otherwise, false.
+ * 
+ * @code
+ * int num;
+ * std::cin >> num;
+ * 
+ * if (isInvalidInput()) {
+ *      std::cout << "Invalid input. Please enter a valid integer." << std::endl;
+ * }
+ * @endcode
+ */
+bool isInvalidInput() {
+    if (cin.fail()) {
+        // Handle datatype mismatch
+        cin.clear();
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        return true;
+    } else if (cin.peek() != '\n') {
+        // Handle extra inputs
+        cin.ignore(numeric_limits<streamsize>::max(), '\n');
+        return true;
+    }
+    else {
+        return false;
+    }
+}
+
+/**
+ * @brief Returns a value for length of an array and validates input.
+ * 
+ * @code
+ * int length = getArrayLengthInput();
+ * 
+ * // Output: "Enter a positive array length: 5" 
+ * // Returns 5
+ * @endcode
+ */
+int getArrayLengthInput() {
+    int length;
+
+    do {
+        cout << "Enter a positive array length: ";
+        cin >> length;
+
+        if (isInvalidInput() || length < 1) {
+            cout << "Invalid input. Please enter a valid integer greater than (0)." << endl;
+        }
+        else {
+            return length;
+        }
+    } while (true);
+}
+
+/**
+ * @brief Returns an array and validates its elements.
+ * 
+ * @param length Number of elements in the array.
+ * 
+ * @note @p length must be a non-negative integer.
+ * 
+ * @code
+ * int length = 5;
+ * int* arr = getArrayInput(length);
+ * 
+ * // Output: "Enter 5 integers separated by spaces: 5 4 3 2 1" 
+ * // Returns {5, 4, 3, 2, 1}
+ * @endcode
+ */
+int* getArrayInput(const int length) {
+    if (length <= 0) {
+        return nullptr;
+    }
+
+    int* arr;
+
+    try {
+        arr = new int[length];
+    } catch (const bad_alloc& e) {
+        return nullptr;
+    }
+
+    do {
+        cout << "Enter " << length << " integers separated by spaces: ";
+
+        for (int i = 0; i < length; i++) {
+            cin >> arr[i];
+        }
+
+        if (isInvalidInput()) {
+            cout << "Invalid input. Enter only " << length << " integers separated by spaces." << endl;
+        }
+        else {
+            return arr;
+        }
+    } while (true);
+}
+
+/**
+ * @brief Returns a copy of an array. 
+ * 
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * 
+ * @return Pointer to a copy of the array.
+ * 
+ * @note @p arr must be a non-null pointer, and @p length must be a non-negative integer.
+ * 
+ * @code
+ * int arr[] = {5, 1, 2, 3, 4};
+ * int arr_copy = deepCopyArray(arr, 5); // arr_copy = {5, 1, 2, 3, 4}
+ * @endcode
+ */
+int* deepCopyArray(const int arr[], const int length) {
+    if (!arr) {
+        return nullptr;
+    }
+    if (length <= 0) {
+        return nullptr;
+    }
+
+    int* arr_copy;
+
+    try {
+        arr_copy = new int[length];
+    } catch (const bad_alloc& e) {
+        return nullptr;
+    }
+
+    copyArray(arr_copy, arr, length);
+    return arr_copy;
+}
+
+/**
+ * @brief Copies an array into another array of the same length, reusing its memory instead of allocating a copy.
+ * 
+ * @param dest Pointer to the array that receives the elements.
+ * @param src Pointer to the array to copy.
+ * @param length Number of elements in both arrays.
+ * 
+ * @note @p dest & @p src must be non-null pointers for the copy to occur.
+ * 
+ * @code
+ * int arr[] = {5, 1, 2, 3, 4};
+ * int arr_copy[5];
+ * copyArray(arr_copy, arr, 5); // arr_copy = {5, 1, 2, 3, 4}
+ * @endcode
+ */
+void copyArray(int dest[], const int src[], const int length) {
+    if (!dest || !src) {
+        return;
+    }
+
+    for (int i = 0; i < length; i++) {
+        dest[i] = src[i];
+    }
+}
+
+/**
+ * @brief Prompts the user for integer input and validates it.
+ * 
+ * @return Integer entered by the user.
+ * 
+ * @code
+ * int value = getIntegerInput();
+ * std::cout << "You entered: " << value << std::endl;
+ * @endcode
+ */
+int getIntegerInput() {
+    int value;
+
+    do {
+        cout << "Enter an integer: ";
+        cin >> value;
+
+        if (isInvalidInput()) {
+            cout << "Invalid input. Please enter a valid integer." << endl;
+        }
+        else {
+            return value;
+        }
+    } while (true);
+}
+
+/**
+ * @brief Prints the elements in an array.
+ * 
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * 
+ * @note @p arr must be a non-null pointer, and @p length must be a non-negative integer.
+ * 
+ * @code
+ * int arr[] = {5, 1, 2, 3, 4};
+ * printArray(arr, 5) // Output: "Array elements: 5 1 2 3 4"
+ * @endcode
+ */
+void printArray(const int arr[], const int length) {
+    if (!arr) {
+        return;
+    }
+    if (length < 0) {
+        return;
+    }
+    if (length == 0) {
+        cout << "Array is empty." << endl;
+    }
+
+    cout << "Array elements: ";
+
+    for (int i = 0; i < length; i++) {
+        cout << arr[i] << ' ';
+    }
+    cout << endl;
+}
+
+/**
+ * @brief Checks whether a character separates integers in a bulk file.
+ */
+static inline bool isSeparator(const char c) {
+    return c == ' ' || c == '\n' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * @brief Appends a batch of integers to a growable array, doubling its capacity until they fit.
+ * 
+ * @return True, if the batch was appended; false, if memory ran out or the array would exceed INT_MAX elements.
+ */
+static bool appendIntegers(int** arr, int* length, int* capacity, const int batch[], const int count) {
+    if (count > INT_MAX - *length) {
+        return false;
+    }
+
+    if (*length + count > *capacity) {
+        int new_capacity = std::max(1024, *capacity);
+        while (new_capacity < *length + count) {
+            new_capacity = new_capacity > INT_MAX/2 ? INT_MAX : new_capacity * 2;
+        }
+
+        int* grown;
+
+        try {
+            grown = new int[new_capacity];
+        } catch (const bad_alloc& e) {
+            return false;
+        }
+
+        std::copy(*arr, *arr + *length, grown);
+        delete[] *arr;
+        *arr = grown;
+        *capacity = new_capacity;
+    }
+
+    std::copy(batch, batch + count, *arr + *length);
+    *length += count;
+    return true;
+}
+
+/**
+ * @brief Collects the integers streamIntegerFile hands out into a growable array.
+ */
+struct IntegerCollector {
+    int* values;
+    int count;
+    int capacity;
+};
+
+/**
+ * @brief Appends a batch of integers to an IntegerCollector, for readIntegerFile.
+ *
+ * @return 0, if the batch was appended; -4, if memory ran out or the array reached INT_MAX elements.
+ */
+static int collectIntegers(const int batch[], const int length, void* context) {
+    IntegerCollector* collector = static_cast<IntegerCollector*>(context);
+
+    if (!appendIntegers(&collector->values, &collector->count, &collector->capacity, batch, length)) {
+        return -4;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Reads whitespace-separated integers from a file in large blocks.
+ * 
+ * Collects the batches of streamIntegerFile into one array.
+ * 
+ * @param path Path of the file to read, or "-" for standard input.
+ * @param arr Pointer that receives a new[]-allocated array of the integers. Free it with delete[].
+ * @param length Pointer that receives the number of integers read.
+ * 
+ * @return 0, if every integer was read.
+ * @return -2, if @p path, @p arr or @p length is null.
+ * @return -4, if the file could not be read or the integers do not fit in memory.
+ * @return -5, if the file holds something other than integers in the int range.
+ * 
+ * @code
+ * int* arr;
+ * int length;
+ * 
+ * if (readIntegerFile("input.txt", &arr, &length) == 0) {
+ *     introSort(arr, length);
+ *     delete[] arr;
+ * }
+ * @endcode
+ */
+int readIntegerFile(const char* path, int** arr, int* length) {
+    if (!path || !arr || !length) {
+        return -2;
+    }
+
+    IntegerCollector collector = {nullptr, 0, 0};
+    int status = streamIntegerFile(path, collectIntegers, &collector);
+
+    if (status != 0) {
+        delete[] collector.values;
+        return status;
+    }
+
+    *arr = collector.values;
+    *length = collector.count;
+    return 0;
+}
+
+/**
+ * @brief Reads whitespace-separated integers from a file or a never-ending stream, handing them out in batches.
+ * 
+ * Parses each block in place with std::from_chars; a number cut by the end of a block
+ * is carried over to the front of the next one. Blocks are read with read(2), which
+ * returns as soon as any input is available, so a slow producer (e.g. a pipe fed by a
+ * telemetry agent) sees its integers consumed as they arrive rather than once 4 MiB
+ * have accumulated. Memory stays at one read buffer & one batch however long the input is.
+ * 
+ * @param path Path of the file to read, or "-" for standard input.
+ * @param consume Called with each batch of at most STREAM_BATCH_INTS integers, in input order,
+ *                & @p context; returns 0 to continue or a non-zero status to stop reading.
+ *                A batch is handed out when full or when the input pauses.
+ * @param context Passed to @p consume.
+ * 
+ * @return 0, if every integer was consumed.
+ * @return -2, if @p path or @p consume is null.
+ * @return -4, if the file could not be read.
+ * @return -5, if the file holds something other than integers in the int range.
+ * @return The status of @p consume, if it stopped the reading.
+ * 
+ * @code
+ * long long sum = 0;
+ * 
+ * streamIntegerFile("-", [](const int batch[], const int length, void* context) {
+ *     for (int i = 0; i < length; i++) *static_cast<long long*>(context) += batch[i];
+ *     return 0;
+ * }, &sum);
+ * @endcode
+ */
+int streamIntegerFile(const char* path, int (*consume)(const int[], const int, void*), void* context) {
+    if (!path || !consume) {
+        return -2;
+    }
+
+    int fd = std::strcmp(path, "-") == 0 ? STDIN_FILENO : open(path, O_RDONLY);
+    if (fd < 0) {
+        return -4;
+    }
+
+    char* buffer = nullptr;
+    int* batch = nullptr;
+
+    try {
+        buffer = new char[IO_BUFFER_BYTES];
+        batch = new int[STREAM_BATCH_INTS];
+    } catch (const bad_alloc& e) {
+        delete[] buffer;
+        if (fd != STDIN_FILENO) close(fd);
+        return -4;
+    }
+
+    int count = 0;
+    int status = 0;
+    size_t carry = 0;
+
+    while (status == 0) {
+        ssize_t read_bytes = read(fd, buffer + carry, IO_BUFFER_BYTES - carry);
+
+        if (read_bytes < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            status = -4;
+            break;
+        }
+
+        bool at_end = read_bytes == 0;
+        const char* p = buffer;
+        const char* end = buffer + carry + read_bytes;
+        carry = 0;
+
+        while (p < end) {
+            while (p < end && isSeparator(*p)) p++;
+            if (p == end) break;
+
+            const char* token = p;
+            while (p < end && !isSeparator(*p)) p++;
+
+            // The token may continue in the next block; keep it for the next read.
+            if (p == end && !at_end) {
+                carry = end - token;
+                if (carry > MAX_INT_CHARS) {
+                    status = -5;
+                }
+                else {
+                    std::memmove(buffer, token, carry);
+                }
+                break;
+            }
+
+            int value;
+            auto parsed = std::from_chars(token, p, value);
+            if (parsed.ec != std::errc() || parsed.ptr != p) {
+                status = -5;
+                break;
+            }
+
+            batch[count++] = value;
+            if (count == STREAM_BATCH_INTS) {
+                status = consume(batch, count, context);
+                count = 0;
+                if (status != 0) break;
+            }
+        }
+
+        // Hand out what has arrived before waiting for more input.
+        if (status == 0 && count > 0) {
+            status = consume(batch, count, context);
+            count = 0;
+        }
+
+        if (at_end) {
+            break;
+        }
+    }
+
+    delete[] buffer;
+    delete[] batch;
+    if (fd != STDIN_FILENO) {
+        close(fd);
+    }
+
+    return status;
+}
+
+/**
+ * @brief Writes integers to a file, one per line, through a large output buffer.
+ * 
+ * Formats with std::to_chars & issues one write per 4 MiB of text, so most outputs
+ * are written with a single call.
+ * 
+ * @param path Path of the file to write, or "-" for standard output.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * 
+ * @return 0, if every integer was written.
+ * @return -2, if @p path or @p arr is null or if @p length is negative.
+ * @return -4, if the file could not be written.
+ * 
+ * @code
+ * int arr[] = {1, 2, 3};
+ * writeIntegerFile("output.txt", arr, 3); // output.txt holds "1\n2\n3\n"
+ * @endcode
+ */
+int writeIntegerFile(const char* path, const int arr[], const int length) {
+    if (!path || (!arr && length > 0)) {
+        return -2;
+    }
+    if (length < 0) {
+        return -2;
+    }
+
+    FILE* file = std::strcmp(path, "-") == 0 ? stdout : std::fopen(path, "wb");
+    if (!file) {
+        return -4;
+    }
+
+    size_t capacity = std::min(IO_BUFFER_BYTES, (size_t)length * (MAX_INT_CHARS + 1) + 1);
+    char* buffer;
+
+    try {
+        buffer = new char[capacity];
+    } catch (const bad_alloc& e) {
+        if (file != stdout) std::fclose(file);
+        return -4;
+    }
+
+    int status = 0;
+    size_t used = 0;
+
+    for (int i = 0; i < length && status == 0; i++) {
+        if (capacity - used < MAX_INT_CHARS + 1) {
+            if (std::fwrite(buffer, 1, used, file) != used) status = -4;
+            used = 0;
+        }
+
+        char* next = std::to_chars(buffer + used, buffer + capacity, arr[i]).ptr;
+        *next = '\n';
+        used = next + 1 - buffer;
+    }
+
+    if (status == 0 && used > 0 && std::fwrite(buffer, 1, used, file) != used) {
+        status = -4;
+    }
+    if (std::fflush(file) != 0) {
+        status = -4;
+    }
+
+    delete[] buffer;
+    if (file != stdout && std::fclose(file) != 0) {
+        status = -4;
+    }
+
+    return status;
+}
+
+/**
+ * @brief Returns the value of a "--name=value" command-line option.
+ * 
+ * @param argc, argv Arguments passed to main.
+ * @param name Option name without the leading dashes.
+ * 
+ * @return Pointer to the value inside @p argv, if the option is present; otherwise, nullptr.
+ * 
+ * @code
+ * // ./sort --algo=intro
+ * getOption(argc, argv, "algo"); // Returns "intro"
+ * @endcode
+ */
+const char* getOption(int argc, char* argv[], const char* name) {
+    size_t name_length = std::strlen(name);
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+
+        if (std::strncmp(arg, "--", 2) == 0 && std::strncmp(arg + 2, name, name_length) == 0
+            && arg[2 + name_length] == '=') {
+            return arg + 3 + name_length;
+        }
+    }
+
+    return nullptr;
+}
+
+/**
+ * @brief Checks whether a "--name" flag was passed on the command line.
+ * 
+ * @param argc, argv Arguments passed to main.
+ * @param name Flag name without the leading dashes.
+ * 
+ * @return True, if the flag is present; otherwise, false.
+ */
+bool hasFlag(int argc, char* argv[], const char* name) {
+    for (int i = 1; i < argc; i++) {
+        if (std::strncmp(argv[i], "--", 2) == 0 && std::strcmp(argv[i] + 2, name) == 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Returns the first argument that is not one of the known options or flags.
+ * 
+ * @param argc, argv Arguments passed to main.
+ * @param known Null-terminated list of option & flag names without the leading dashes.
+ * 
+ * @return The unknown argument; nullptr, if every argument is known.
+ * 
+ * @code
+ * const char* const known[] = {"algo", "input", nullptr};
+ * // ./sort --algo=intro --colour=red
+ * findUnknownOption(argc, argv, known); // Returns "--colour=red"
+ * @endcode
+ */
+const char* findUnknownOption(int argc, char* argv[], const char* const known[]) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool matched = false;
+
+        if (std::strncmp(arg, "--", 2) == 0) {
+            const char* name = arg + 2;
+            size_t name_length = std::strcspn(name, "=");
+
+            for (int k = 0; known[k] && !matched; k++) {
+                matched = std::strlen(known[k]) == name_length && std::strncmp(known[k], name, name_length) == 0;
+            }
+        }
+
+        if (!matched) {
+            return arg;
+        }
+    }
+
+    return nullptr;
+}
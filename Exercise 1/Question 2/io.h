@@ -0,0 +1,36 @@
+/**
+ * @file io.h
+ * @brief Input & output utilities - Interactive prompts, Bulk integer files, Command-line options.
+ * 
+ * Provides function declarations shared by the search & sort programs.
+ * 
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#pragma once
+
+// ====== Utilities ======
+bool isInvalidInput();
+
+// ====== Array Utilities ======
+int getArrayLengthInput();
+int* getArrayInput(const int);
+int* deepCopyArray(const int[], const int);
+void copyArray(int[], const int[], const int);
+
+// ====== Input Utilities ======
+int getIntegerInput();
+
+// ====== Printing Utilities ======
+void printArray(const int[], const int);
+
+// ====== Bulk File Utilities ======
+int readIntegerFile(const char*, int**, int*);
+int streamIntegerFile(const char*, int (*consume)(const int[], const int, void*), void*);
+int writeIntegerFile(const char*, const int[], const int);
+
+// ====== Command-line Utilities ======
+const char* getOption(int, char*[], const char*);
+bool hasFlag(int, char*[], const char*);
+const char* findUnknownOption(int, char*[], const char* const[]);
@@ -0,0 +1,210 @@
+/**
+ * @file linear_search.cpp
+ * @brief Linear Search algorithms - First match, Match count, All matches.
+ * 
+ * Provides function definitions for the linear searches declared in search.h.
+ * 
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include "search.h"
+#include "simd.h"
+#include "sort_stats.h"
+#include "span_api.h"
+
+// ====== Searching Functions ======
+int linearSearch(const int, const int[], const int);
+int linearSearchCount(const int, const int[], const int);
+int linearSearchAll(const int, const int[], const int, int[], const int);
+
+namespace dsa {
+// ====== 64-bit Searching Functions ======
+std::optional<size_t> linearSearch(const int, std::span<const int>);
+size_t linearSearchCount(const int, std::span<const int>);
+size_t linearSearchAll(const int, std::span<const int>, std::span<size_t>);
+}
+
+// Elements per simdFindAll call in dsa::linearSearchAll, so that every match of a chunk fits an int buffer on the stack.
+static const size_t FIND_ALL_CHUNK = 4096;
+
+
+/**
+ * @brief Returns the index of the first occurrence of an element in the array using linear search algorithm.
+ * 
+ * Compares 32 elements per step with AVX2 (4 with SSE4.1) & stops at the first block holding a match.
+ * 
+ * @param value Number to be searched in the array.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * 
+ * @return Index of @p value in the array, if found; otherwise, -1.
+ * @return -2, if @p arr is null or if @p length is a non-negative integer.
+ * 
+ * @code
+ * int arr[] = {5, 1, 2, 3, 4};
+ * 
+ * linearSearch(3, arr, 5); // Returns 3
+ * linearSearch(6, arr, 5); // Returns -1
+ * @endcode
+ */
+int linearSearch(const int value, const int arr[], const int length) {
+    if (arr == NULL) {
+        return -2;
+    }
+    if (length <= 0) {
+        return -2;
+    }
+
+    int idx = simdFindFirst(value, arr, length);
+    countComparisons(idx >= 0 ? idx + 1 : length);
+    return idx;
+}
+
+/**
+ * @brief Returns the number of occurrences of an element in the array.
+ * 
+ * @param value Number to be counted in the array.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * 
+ * @return Number of elements equal to @p value.
+ * @return -2, if @p arr is null or if @p length is a non-positive integer.
+ * 
+ * @code
+ * int arr[] = {3, 1, 3, 3, 4};
+ * 
+ * linearSearchCount(3, arr, 5); // Returns 3
+ * linearSearchCount(6, arr, 5); // Returns 0
+ * @endcode
+ */
+int linearSearchCount(const int value, const int arr[], const int length) {
+    if (arr == NULL) {
+        return -2;
+    }
+    if (length <= 0) {
+        return -2;
+    }
+
+    return simdCountEqual(value, arr, length);
+}
+
+/**
+ * @brief Writes the index of every occurrence of an element in the array, in increasing order, in one pass.
+ * 
+ * @param value Number to be searched in the array.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param indices Caller-provided buffer that receives the indices.
+ * @param capacity Number of indices @p indices can hold.
+ * 
+ * @return Total number of occurrences. If it exceeds @p capacity, only the first @p capacity indices are written.
+ * @return -2, if @p arr or @p indices is null, if @p length is a non-positive integer or if @p capacity is negative.
+ * 
+ * @code
+ * int arr[] = {3, 1, 3, 3, 4};
+ * int indices[5];
+ * 
+ * linearSearchAll(3, arr, 5, indices, 5); // Returns 3, indices = {0, 2, 3}
+ * linearSearchAll(3, arr, 5, indices, 1); // Returns 3, indices = {0}
+ * @endcode
+ */
+int linearSearchAll(const int value, const int arr[], const int length, int indices[], const int capacity) {
+    if (arr == NULL || indices == NULL) {
+        return -2;
+    }
+    if (length <= 0 || capacity < 0) {
+        return -2;
+    }
+
+    return simdFindAll(value, arr, length, indices, capacity);
+}
+
+/**
+ * @brief Returns the index of the first occurrence of an element in the array using linear search algorithm.
+ * 
+ * Runs the SIMD kernel on blocks of SIMD_MAX_BLOCK elements, so any length is supported.
+ * 
+ * @param value Number to be searched in the array.
+ * @param arr Array to search.
+ * 
+ * @return Index of @p value in the array; std::nullopt, if it is not in the array.
+ * 
+ * @code
+ * std::vector<int> arr = {5, 1, 2, 3, 4};
+ * 
+ * dsa::linearSearch(3, arr); // Returns 3
+ * dsa::linearSearch(6, arr); // Returns std::nullopt
+ * @endcode
+ */
+std::optional<size_t> dsa::linearSearch(const int value, std::span<const int> arr) {
+    for (size_t begin = 0; begin < arr.size(); begin += SIMD_MAX_BLOCK) {
+        int idx = simdFindFirst(value, arr.data() + begin, (int)std::min(SIMD_MAX_BLOCK, arr.size() - begin));
+        if (idx >= 0) {
+            return begin + idx;
+        }
+    }
+
+    return std::nullopt;
+}
+
+/**
+ * @brief Returns the number of occurrences of an element in the array.
+ * 
+ * @param value Number to be counted in the array.
+ * @param arr Array to search.
+ * 
+ * @return Number of elements equal to @p value.
+ */
+size_t dsa::linearSearchCount(const int value, std::span<const int> arr) {
+    size_t count = 0;
+
+    for (size_t begin = 0; begin < arr.size(); begin += SIMD_MAX_BLOCK) {
+        count += simdCountEqual(value, arr.data() + begin, (int)std::min(SIMD_MAX_BLOCK, arr.size() - begin));
+    }
+
+    return count;
+}
+
+/**
+ * @brief Writes the index of every occurrence of an element in the array, in increasing order.
+ * 
+ * One pass: runs the SIMD kernel of the int version on chunks of FIND_ALL_CHUNK elements
+ * & adds each chunk's offset to its indices, then only counts once @p indices is full.
+ * 
+ * @param value Number to be searched in the array.
+ * @param arr Array to search.
+ * @param indices Caller-provided buffer that receives the indices.
+ * 
+ * @return Total number of occurrences. If it exceeds indices.size(), only the first indices.size() indices are written.
+ * 
+ * @code
+ * std::vector<int> arr = {3, 1, 3, 3, 4};
+ * std::vector<size_t> indices(2);
+ * 
+ * dsa::linearSearchAll(3, arr, indices); // Returns 3, indices = {0, 2}
+ * @endcode
+ */
+size_t dsa::linearSearchAll(const int value, std::span<const int> arr, std::span<size_t> indices) {
+    int chunk_indices[FIND_ALL_CHUNK];
+    size_t count = 0;
+    size_t begin = 0;
+
+    for (; begin < arr.size() && count < indices.size(); begin += FIND_ALL_CHUNK) {
+        int length = (int)std::min(FIND_ALL_CHUNK, arr.size() - begin);
+        int found = simdFindAll(value, arr.data() + begin, length, chunk_indices, (int)FIND_ALL_CHUNK);
+
+        for (int i = 0; i < found && count + i < indices.size(); i++) {
+            indices[count + i] = begin + chunk_indices[i];
+        }
+        count += found;
+    }
+
+    for (; begin < arr.size(); begin += SIMD_MAX_BLOCK) {
+        count += simdCountEqual(value, arr.data() + begin, (int)std::min(SIMD_MAX_BLOCK, arr.size() - begin));
+    }
+
+    return count;
+}
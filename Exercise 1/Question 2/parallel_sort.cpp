@@ -0,0 +1,183 @@
+/**
+ * @file parallel_sort.cpp
+ * @brief Parallel Merge Sort on a work-stealing thread pool.
+ *
+ * Provides function definitions for the multi-threaded merge sort declared in sort.h.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <algorithm>
+#include <functional>
+#include "scratch_arena.h"
+#include "sort.h"
+#include "span_api.h"
+#include "thread_pool.h"
+
+// ====== Sorting Functions ======
+void parallelMergeSort(int[], const int, bool desc, int num_threads);
+
+namespace dsa {
+// ====== 64-bit Sorting Functions ======
+void parallelMergeSort(std::span<int>, bool desc, int num_threads);
+}
+
+// Ranges of at most this many elements are handed to insertionSort.
+static const long MERGE_SORT_INSERTION_CUTOFF = 32;
+// Ranges smaller than this are sorted or merged on the current thread instead of being split into tasks.
+static const long PARALLEL_CUTOFF = 1 << 13;
+
+
+/**
+ * @brief Merges the sorted ranges @p a & @p b into @p out, splitting large merges into parallel tasks.
+ *
+ * The larger input is cut at its middle element, the smaller input at the matching
+ * bound, and both halves are merged independently. Ties take the element of @p a
+ * first, so the merge is stable.
+ *
+ * @param a, na First sorted range & its length.
+ * @param b, nb Second sorted range & its length.
+ * @param out Destination with room for @p na + @p nb elements; must not overlap the inputs.
+ * @param comp Strict weak ordering.
+ * @param pool Pool to run the split halves on.
+ */
+template <typename Compare>
+static void parallelMerge(const int* a, long na, const int* b, long nb, int* out, Compare comp, ThreadPool& pool) {
+    if (na + nb < PARALLEL_CUTOFF) {
+        std::merge(a, a+na, b, b+nb, out, comp);
+        return;
+    }
+
+    long a_mid, b_mid;
+
+    if (na >= nb) {
+        a_mid = na / 2;
+        b_mid = std::lower_bound(b, b+nb, a[a_mid], comp) - b;
+    } else {
+        b_mid = nb / 2;
+        a_mid = std::upper_bound(a, a+na, b[b_mid], comp) - a;
+    }
+
+    TaskGroup group(pool);
+    group.run([=, &pool] {
+        parallelMerge(a, a_mid, b, b_mid, out, comp, pool);
+    });
+    parallelMerge(a+a_mid, na-a_mid, b+b_mid, nb-b_mid, out+a_mid+b_mid, comp, pool);
+    group.wait();
+}
+
+/**
+ * @brief Sorts @p src[0..length) using @p dst as scratch, leaving the result in @p dst if @p into_dst; otherwise, in @p src.
+ *
+ * @param src Range to sort.
+ * @param dst Scratch buffer of the same length.
+ * @param length Number of elements in the range.
+ * @param into_dst Whether the sorted output must end up in @p dst.
+ * @param comp Strict weak ordering.
+ * @param pool Pool to run the halves on.
+ */
+template <typename Compare>
+static void parallelMergeSortRange(int* src, int* dst, long length, bool into_dst, Compare comp, ThreadPool& pool) {
+    if (length <= MERGE_SORT_INSERTION_CUTOFF) {
+        insertionSort(src, src+length, comp);
+        if (into_dst) {
+            std::copy(src, src+length, dst);
+        }
+        return;
+    }
+
+    long half = length / 2;
+
+    // The halves alternate buffers, so every merge reads one buffer & writes the other with no copy back.
+    if (length >= PARALLEL_CUTOFF) {
+        TaskGroup group(pool);
+        group.run([=, &pool] {
+            parallelMergeSortRange(src, dst, half, !into_dst, comp, pool);
+        });
+        parallelMergeSortRange(src+half, dst+half, length-half, !into_dst, comp, pool);
+        group.wait();
+    } else {
+        parallelMergeSortRange(src, dst, half, !into_dst, comp, pool);
+        parallelMergeSortRange(src+half, dst+half, length-half, !into_dst, comp, pool);
+    }
+
+    const int* from = into_dst ? src : dst;
+    int* to = into_dst ? dst : src;
+    parallelMerge(from, half, from+half, length-half, to, comp, pool);
+}
+
+/**
+ * @brief Sorts the array in ascending order using a multi-threaded Merge sort algorithm.
+ *
+ * Splits the array recursively into tasks on a work-stealing thread pool and merges
+ * the halves with a parallel merge. Ranges of 32 or fewer elements are sorted with
+ * insertion sort. Produces exactly the same output as the sequential sorts.
+ *
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param desc If true, sorts the array in descending order; otherwise, sorts it in ascending order. (default=false)
+ * @param num_threads Number of threads to use. If non-positive, uses the number of hardware threads. (default=0)
+ *
+ * @note @p arr must be a non-null pointer, and @p length must be a non-negative integer.
+ * @note Needs a scratch buffer of @p length integers; if it cannot be allocated, falls back to introSort.
+ *
+ * @code
+ * int arr[] = {5, 1, 2, 3, 4};
+ *
+ * parallelMergeSort(arr, 5);
+ * // Sorted array: 1 2 3 4 5
+ *
+ * parallelMergeSort(arr, 5, true, 8);
+ * // Sorted array: 5 4 3 2 1
+ * @endcode
+ */
+void parallelMergeSort(int arr[], const int length, const bool desc, const int num_threads) {
+    if (!arr) {
+        return;
+    }
+    if (length <= 0) {
+        return;
+    }
+
+    dsa::parallelMergeSort(std::span<int>(arr, length), desc, num_threads);
+}
+
+/**
+ * @brief Sorts the array in ascending order using a multi-threaded Merge sort algorithm.
+ *
+ * Same algorithm as parallelMergeSort, for arrays of any length.
+ *
+ * @param arr Array to sort.
+ * @param desc If true, sorts the array in descending order; otherwise, sorts it in ascending order. (default=false)
+ * @param num_threads Number of threads to use. If non-positive, uses the number of hardware threads. (default=0)
+ *
+ * @note Needs a scratch buffer of arr.size() integers; if it cannot be allocated, falls back to introSort.
+ */
+void dsa::parallelMergeSort(std::span<int> arr, const bool desc, const int num_threads) {
+    /*
+    Out-of-place parallel Merge sort.
+    */
+    const size_t length = arr.size();
+    if (length == 0) {
+        return;
+    }
+
+    ScratchArena& arena = threadScratchArena();
+    ScratchScope scope(arena);
+    int* scratch = arena.allocateArray<int>(length);
+
+    if (!scratch) {
+        dsa::introSort(arr, desc);
+        return;
+    }
+
+    // An input that is never split into tasks runs on the caller alone, without waking the workers.
+    ThreadPool& pool = sharedThreadPool(length < (size_t)PARALLEL_CUTOFF ? 1 : num_threads);
+
+    if (desc) {
+        parallelMergeSortRange(arr.data(), scratch, length, false, std::greater<int>(), pool);
+    } else {
+        parallelMergeSortRange(arr.data(), scratch, length, false, std::less<int>(), pool);
+    }
+}
@@ -0,0 +1,181 @@
+/**
+ * @file partial_sort.cpp
+ * @brief Selection algorithms - Partial Sort, Nth Element, Top-k.
+ *
+ * Provides function definitions for the selection functions declared in sort.h & span_api.h.
+ * They answer "the k smallest" or "the k-th smallest" without sorting the whole array:
+ * nthElement in O(n), partialSort in O(n + k log k) & topK in O(n log k) with O(k) memory.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <algorithm>
+#include <functional>
+#include "sort.h"
+#include "span_api.h"
+#include "top_k.h"
+
+// ====== Selection Functions ======
+int partialSort(int[], const int, const int, bool desc);
+int nthElement(int[], const int, const int, bool desc);
+int topK(const int[], const int, const int, int[], bool desc);
+
+namespace dsa {
+// ====== 64-bit Selection Functions ======
+void partialSort(std::span<int>, size_t, bool desc);
+void nthElement(std::span<int>, size_t, bool desc);
+}
+
+
+/**
+ * @brief Sorts the @p k smallest elements of the array into its first @p k positions.
+ *
+ * The other elements end up after them in unspecified order.
+ *
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param k Number of elements to sort into place.
+ * @param desc If true, sorts the @p k largest elements in descending order instead. (default=false)
+ *
+ * @return 0, if the first @p k elements are in place.
+ * @return -2, if @p arr is null, if @p length is a non-positive integer or if @p k is not in [0, @p length].
+ *
+ * @code
+ * int arr[] = {9, 1, 8, 2, 7, 3};
+ *
+ * partialSort(arr, 6, 3); // arr = {1, 2, 3, ...}
+ * partialSort(arr, 6, 2, true); // arr = {9, 8, ...}
+ * @endcode
+ */
+int partialSort(int arr[], const int length, const int k, const bool desc) {
+    if (!arr) {
+        return -2;
+    }
+    if (length <= 0 || k < 0 || k > length) {
+        return -2;
+    }
+
+    dsa::partialSort(std::span<int>(arr, length), k, desc);
+    return 0;
+}
+
+/**
+ * @brief Moves the element a full sort would put at index @p k there, in O(n).
+ *
+ * Elements before index @p k end up no greater than it & elements after it no smaller
+ * (the reverse, if @p desc). Finds the median, a percentile or the k-th smallest element.
+ *
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param k Index to fill.
+ * @param desc If true, selects as if sorting in descending order. (default=false)
+ *
+ * @return 0, if arr[k] holds the k-th element.
+ * @return -2, if @p arr is null, if @p length is a non-positive integer or if @p k is not in [0, @p length).
+ *
+ * @code
+ * int arr[] = {9, 1, 8, 2, 7};
+ *
+ * nthElement(arr, 5, 2); // arr[2] = 7, the median
+ * nthElement(arr, 5, 0, true); // arr[0] = 9, the maximum
+ * @endcode
+ */
+int nthElement(int arr[], const int length, const int k, const bool desc) {
+    if (!arr) {
+        return -2;
+    }
+    if (length <= 0 || k < 0 || k >= length) {
+        return -2;
+    }
+
+    dsa::nthElement(std::span<int>(arr, length), k, desc);
+    return 0;
+}
+
+/**
+ * @brief Writes the @p k smallest elements of the array to @p out in ascending order, without modifying the array.
+ *
+ * Streams the array through a TopK heap of @p k elements: O(n log k) time, no memory
+ * beyond @p out & the heap, & a single pass, so it also suits arrays too large to copy.
+ *
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param k Number of elements to write.
+ * @param out Pointer to @p k integers that receive the elements.
+ * @param desc If true, writes the @p k largest elements in descending order instead. (default=false)
+ *
+ * @return 0, if @p out holds the elements.
+ * @return -2, if @p arr or @p out is null, if @p length is a non-positive integer or if @p k is not in [0, @p length].
+ *
+ * @code
+ * int arr[] = {9, 1, 8, 2, 7, 3};
+ * int out[3];
+ *
+ * topK(arr, 6, 3, out); // out = {1, 2, 3}
+ * topK(arr, 6, 3, out, true); // out = {9, 8, 7}
+ * @endcode
+ */
+int topK(const int arr[], const int length, const int k, int out[], const bool desc) {
+    if (!arr || !out) {
+        return -2;
+    }
+    if (length <= 0 || k < 0 || k > length) {
+        return -2;
+    }
+
+    std::vector<int> best;
+
+    if (desc) {
+        TopK<int, std::greater<int>> top(k);
+        for (int i = 0; i < length; i++) {
+            top.push(arr[i]);
+        }
+        best = top.sorted();
+    } else {
+        TopK<int, std::less<int>> top(k);
+        for (int i = 0; i < length; i++) {
+            top.push(arr[i]);
+        }
+        best = top.sorted();
+    }
+
+    std::copy(best.begin(), best.end(), out);
+    return 0;
+}
+
+/**
+ * @brief Sorts the @p k smallest elements of the array into its first @p k positions.
+ *
+ * @param arr Array to partially sort.
+ * @param k Number of elements to sort into place. If greater than arr.size(), sorts the whole array.
+ * @param desc If true, sorts the @p k largest elements in descending order instead. (default=false)
+ */
+void dsa::partialSort(std::span<int> arr, const size_t k, const bool desc) {
+    auto middle = arr.begin() + std::min(k, arr.size());
+
+    if (desc) {
+        ::partialSort(arr.begin(), middle, arr.end(), std::greater<int>());
+    } else {
+        ::partialSort(arr.begin(), middle, arr.end(), std::less<int>());
+    }
+}
+
+/**
+ * @brief Moves the element a full sort would put at index @p k there, in O(n).
+ *
+ * @param arr Array to partially sort.
+ * @param k Index to fill. If not less than arr.size(), nothing happens.
+ * @param desc If true, selects as if sorting in descending order. (default=false)
+ */
+void dsa::nthElement(std::span<int> arr, const size_t k, const bool desc) {
+    if (k >= arr.size()) {
+        return;
+    }
+
+    if (desc) {
+        ::nthElement(arr.begin(), arr.begin() + k, arr.end(), std::greater<int>());
+    } else {
+        ::nthElement(arr.begin(), arr.begin() + k, arr.end(), std::less<int>());
+    }
+}
@@ -0,0 +1,319 @@
+/**
+ * @file quantile_sketch.cpp
+ * @brief Quantile sketch - Approximate quantiles & ranks of an unbounded stream of integers in bounded memory.
+ *
+ * Provides function definitions for QuantileSketch.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include "quantile_sketch.h"
+#include "sort.h"
+
+// Ratio between the capacities of consecutive levels, from the top down.
+static const double LEVEL_CAPACITY_RATIO = 2.0 / 3.0;
+// Smallest capacity of a level; a level must hold a pair to compact it.
+static const size_t MIN_LEVEL_CAPACITY = 2;
+
+
+/**
+ * @brief Creates an empty sketch.
+ *
+ * @param k Accuracy parameter: memory grows linearly with it & the rank error shrinks as 1/k. (default=200)
+ *
+ * @code
+ * QuantileSketch sketch;
+ *
+ * for (int latency : latencies) {
+ *     sketch.update(latency);
+ * }
+ * int p99 = sketch.quantile(0.99);
+ * @endcode
+ */
+QuantileSketch::QuantileSketch(int k)
+    : k_(std::max(k, QUANTILE_SKETCH_MIN_K)), retained_(0), max_retained_(0),
+      count_(0), min_(0), max_(0), rng_(0x9E3779B97F4A7C15ULL) {
+    addLevel();
+}
+
+/**
+ * @brief Returns the number of items a level may hold before it is compacted.
+ *
+ * The top level holds k items & each level below 2/3 as many, so the levels that see
+ * the most compactions, & the most error, are the smallest.
+ */
+size_t QuantileSketch::levelCapacity(const size_t level) const {
+    double depth = (double)(levels_.size() - 1 - level);
+    size_t capacity = (size_t)std::ceil(k_ * std::pow(LEVEL_CAPACITY_RATIO, depth));
+
+    return std::max(capacity, MIN_LEVEL_CAPACITY);
+}
+
+/**
+ * @brief Adds a level on top & recomputes the capacity of the sketch.
+ */
+void QuantileSketch::addLevel() {
+    levels_.emplace_back();
+    levels_.back().reserve(k_);
+
+    max_retained_ = 0;
+    for (size_t h = 0; h < levels_.size(); h++) {
+        max_retained_ += levelCapacity(h);
+    }
+}
+
+/**
+ * @brief Compacts full levels, lowest first, until the sketch has room again.
+ *
+ * Sorts the level & promotes every other item, starting at a random offset of 0 or 1,
+ * to the level above with twice the weight. If the level holds an odd number of items,
+ * one stays behind, so the total weight is preserved exactly.
+ */
+void QuantileSketch::compress() {
+    for (size_t h = 0; h < levels_.size(); h++) {
+        if (levels_[h].size() < levelCapacity(h)) {
+            continue;
+        }
+        if (h + 1 == levels_.size()) {
+            addLevel();
+        }
+
+        std::vector<int>& level = levels_[h];
+        std::vector<int>& above = levels_[h + 1];
+
+        bool odd = level.size() % 2 == 1;
+        int held = odd ? level.back() : 0;
+        if (odd) {
+            level.pop_back();
+        }
+
+        introSort(level.data(), (int)level.size());
+
+        rng_ ^= rng_ << 13;
+        rng_ ^= rng_ >> 7;
+        rng_ ^= rng_ << 17;
+
+        for (size_t i = rng_ & 1; i < level.size(); i += 2) {
+            above.push_back(level[i]);
+        }
+
+        retained_ -= level.size() / 2;
+        level.clear();
+        if (odd) {
+            level.push_back(held);
+        }
+
+        if (retained_ < max_retained_) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Adds one element of the stream. Amortized O(log k).
+ */
+void QuantileSketch::update(const int value) {
+    if (count_ == 0) {
+        min_ = max_ = value;
+    } else {
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+
+    levels_[0].push_back(value);
+    retained_++;
+    count_++;
+
+    if (retained_ >= max_retained_) {
+        compress();
+    }
+}
+
+/**
+ * @brief Adds a batch of elements of the stream, in order.
+ *
+ * Finds the batch's minimum & maximum with the vectorized findMinMaxIdx, then fills
+ * level 0 with whole runs of the batch between compactions.
+ *
+ * @param values Pointer to the elements.
+ * @param length Number of elements. Nothing happens if it is not positive.
+ */
+void QuantileSketch::update(const int values[], const int length) {
+    int min_idx, max_idx;
+
+    if (!values || findMinMaxIdx(values, length, &min_idx, &max_idx) != 0) {
+        return;
+    }
+
+    if (count_ == 0) {
+        min_ = values[min_idx];
+        max_ = values[max_idx];
+    } else {
+        min_ = std::min(min_, values[min_idx]);
+        max_ = std::max(max_, values[max_idx]);
+    }
+
+    for (int i = 0; i < length; ) {
+        int run = (int)std::min((size_t)(length - i), max_retained_ - retained_);
+
+        levels_[0].insert(levels_[0].end(), values + i, values + i + run);
+        retained_ += run;
+        i += run;
+
+        if (retained_ >= max_retained_) {
+            compress();
+        }
+    }
+
+    count_ += length;
+}
+
+/**
+ * @brief Empties the sketch, keeping its accuracy parameter.
+ */
+void QuantileSketch::clear() {
+    levels_.clear();
+    retained_ = 0;
+    count_ = 0;
+    min_ = max_ = 0;
+    addLevel();
+}
+
+/**
+ * @brief Returns the number of elements added.
+ */
+long long QuantileSketch::count() const {
+    return count_;
+}
+
+/**
+ * @brief Returns the smallest element added, exactly; 0, if the sketch is empty.
+ */
+int QuantileSketch::min() const {
+    return min_;
+}
+
+/**
+ * @brief Returns the largest element added, exactly; 0, if the sketch is empty.
+ */
+int QuantileSketch::max() const {
+    return max_;
+}
+
+/**
+ * @brief Returns the number of items the sketch holds, which bounds its memory.
+ */
+size_t QuantileSketch::retained() const {
+    return retained_;
+}
+
+/**
+ * @brief Returns an element whose normalized rank in the stream is approximately @p q.
+ *
+ * @param q Rank between 0 & 1; 0 returns min() & 1 returns max().
+ *
+ * @note The sketch must not be empty. For several quantiles, quantiles() sorts the items once.
+ *
+ * @code
+ * int median = sketch.quantile(0.5);
+ * @endcode
+ */
+int QuantileSketch::quantile(const double q) const {
+    int result = 0;
+    quantiles(&q, 1, &result);
+    return result;
+}
+
+/**
+ * @brief Computes several quantiles from one sorted pass over the retained items.
+ *
+ * @param qs Pointer to the ranks, each between 0 & 1, in any order.
+ * @param num_qs Number of ranks.
+ * @param out Pointer to @p num_qs integers that receive the elements.
+ *
+ * @return 0, if @p out holds the quantiles.
+ * @return -1, if the sketch is empty.
+ * @return -2, if @p qs or @p out is null or if @p num_qs is a non-positive integer.
+ *
+ * @code
+ * const double qs[] = {0.5, 0.9, 0.99};
+ * int values[3];
+ *
+ * sketch.quantiles(qs, 3, values); // p50, p90, p99
+ * @endcode
+ */
+int QuantileSketch::quantiles(const double qs[], const int num_qs, int out[]) const {
+    if (!qs || !out) {
+        return -2;
+    }
+    if (num_qs <= 0) {
+        return -2;
+    }
+    if (count_ == 0) {
+        return -1;
+    }
+
+    // Each retained item stands for 2^h elements of the stream.
+    std::vector<std::pair<int, long long>> weighted;
+    weighted.reserve(retained_);
+
+    for (size_t h = 0; h < levels_.size(); h++) {
+        for (int value : levels_[h]) {
+            weighted.emplace_back(value, 1LL << h);
+        }
+    }
+
+    std::sort(weighted.begin(), weighted.end());
+
+    for (int i = 0; i < num_qs; i++) {
+        if (qs[i] <= 0) {
+            out[i] = min_;
+            continue;
+        }
+        if (qs[i] >= 1) {
+            out[i] = max_;
+            continue;
+        }
+
+        double target = qs[i] * (double)count_;
+        long long cumulative = 0;
+
+        out[i] = max_;
+        for (const auto& item : weighted) {
+            cumulative += item.second;
+            if ((double)cumulative >= target) {
+                out[i] = item.first;
+                break;
+            }
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Returns the approximate fraction of the stream that is less than or equal to @p value.
+ *
+ * @return Rank between 0 & 1; 0, if the sketch is empty.
+ */
+double QuantileSketch::rank(const int value) const {
+    if (count_ == 0) {
+        return 0;
+    }
+
+    long long weight = 0;
+
+    for (size_t h = 0; h < levels_.size(); h++) {
+        for (int item : levels_[h]) {
+            if (item <= value) {
+                weight += 1LL << h;
+            }
+        }
+    }
+
+    return (double)weight / (double)count_;
+}
@@ -0,0 +1,59 @@
+/**
+ * @file quantile_sketch.h
+ * @brief Quantile sketch - Approximate quantiles & ranks of an unbounded stream of integers in bounded memory.
+ *
+ * QuantileSketch is a KLL sketch (Karnin, Lang & Liberty, 2016). It keeps a stack of
+ * compactors: level h holds items that each stand for 2^h stream elements. When the sketch
+ * is full, the lowest full level is sorted & every other item, from a random offset, is
+ * promoted to the level above, halving that level's memory while keeping ranks unbiased.
+ * Level capacities shrink geometrically (by 2/3) from the top, so the sketch retains
+ * about 3k items however long the stream is, & a rank it reports is within about 1.7/k
+ * of the true normalized rank with high probability (about 1% at the default k = 200).
+ * Count, minimum & maximum are exact.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Accuracy parameter of a QuantileSketch if none is given: about 600 retained items, ~1% rank error.
+static const int QUANTILE_SKETCH_DEFAULT_K = 200;
+// Smallest accuracy parameter a QuantileSketch accepts; smaller values are raised to it.
+static const int QUANTILE_SKETCH_MIN_K = 8;
+
+class QuantileSketch {
+public:
+    explicit QuantileSketch(int k = QUANTILE_SKETCH_DEFAULT_K);
+
+    void update(int value);
+    void update(const int values[], int length);
+    void clear();
+
+    long long count() const;
+    int min() const;
+    int max() const;
+    size_t retained() const;
+
+    int quantile(double q) const;
+    int quantiles(const double qs[], int num_qs, int out[]) const;
+    double rank(int value) const;
+
+private:
+    size_t levelCapacity(size_t level) const;
+    void addLevel();
+    void compress();
+
+    std::vector<std::vector<int>> levels_;  // levels_[h] holds items of weight 2^h.
+    int k_;
+    size_t retained_;       // Items held across all levels.
+    size_t max_retained_;   // Sum of the level capacities; compress() runs when retained_ reaches it.
+    long long count_;
+    int min_;
+    int max_;
+    uint64_t rng_;          // xorshift64 state for the compaction offsets.
+};
@@ -0,0 +1,224 @@
+/**
+ * @file radix_sort.cpp
+ * @brief LSD Radix Sort for 32-bit integers.
+ *
+ * Provides function definitions for the non-comparison sort declared in sort.h.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include "scratch_arena.h"
+#include "sort.h"
+#include "sort_stats.h"
+#include "span_api.h"
+#include "thread_pool.h"
+
+// ====== Sorting Functions ======
+void radixSort(int[], const int, bool desc, int num_threads);
+
+namespace dsa {
+// ====== 64-bit Sorting Functions ======
+void radixSort(std::span<int>, bool desc, int num_threads);
+}
+
+static const int RADIX_BITS = 8;
+static const int RADIX_BUCKETS = 1 << RADIX_BITS;
+static const int RADIX_PASSES = 32 / RADIX_BITS;
+// Inputs smaller than this build their histogram on the calling thread.
+static const size_t PARALLEL_HISTOGRAM_CUTOFF = 1 << 16;
+
+
+/**
+ * @brief Maps an integer to an unsigned key whose unsigned order is the requested sort order.
+ *
+ * Flipping the sign bit moves negative numbers below positive ones; inverting every
+ * bit on top of that reverses the order for descending sorts.
+ */
+static inline uint32_t radixKey(const int value, const bool desc) {
+    uint32_t key = (uint32_t)value ^ 0x80000000u;
+    return desc ? ~key : key;
+}
+
+/**
+ * @brief Adds the digit counts of arr[0..length) for every pass to @p counts.
+ *
+ * @param arr Pointer to the array.
+ * @param length Number of elements to count.
+ * @param desc If true, counts the keys of a descending sort.
+ * @param counts RADIX_PASSES x RADIX_BUCKETS table of counts.
+ */
+static void countDigits(const int arr[], const size_t length, const bool desc, size_t counts[][RADIX_BUCKETS]) {
+    for (size_t i = 0; i < length; i++) {
+        uint32_t key = radixKey(arr[i], desc);
+
+        for (int pass = 0; pass < RADIX_PASSES; pass++) {
+            counts[pass][(key >> (pass*RADIX_BITS)) & (RADIX_BUCKETS-1)]++;
+        }
+    }
+}
+
+/**
+ * @brief Builds the digit histograms of every pass in one read of the array, split across threads.
+ *
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param desc If true, counts the keys of a descending sort.
+ * @param num_threads Number of threads to use. If non-positive, uses the number of hardware threads.
+ * @param counts Zeroed RADIX_PASSES x RADIX_BUCKETS table that receives the totals.
+ */
+static void buildHistograms(const int arr[], const size_t length, const bool desc, const int num_threads,
+                            size_t counts[][RADIX_BUCKETS]) {
+    if (length < PARALLEL_HISTOGRAM_CUTOFF) {
+        countDigits(arr, length, desc, counts);
+        return;
+    }
+
+    ThreadPool& pool = sharedThreadPool(num_threads);
+    int chunks = pool.size();
+    size_t chunk_length = (length + chunks - 1) / chunks;
+
+    // Each chunk counts into a private table so that the threads never share a cache line.
+    ScratchArena& arena = threadScratchArena();
+    ScratchScope scope(arena);
+    size_t* partial = arena.allocateArray<size_t>((size_t)chunks * RADIX_PASSES * RADIX_BUCKETS);
+
+    if (!partial) {
+        countDigits(arr, length, desc, counts);
+        return;
+    }
+    std::memset(partial, 0, (size_t)chunks * RADIX_PASSES * RADIX_BUCKETS * sizeof(size_t));
+
+    {
+        TaskGroup group(pool);
+
+        for (int c = 0; c < chunks; c++) {
+            size_t begin = c * chunk_length;
+            size_t end = std::min(length, begin + chunk_length);
+            if (begin >= end) {
+                break;
+            }
+
+            auto table = (size_t (*)[RADIX_BUCKETS])&partial[(size_t)c * RADIX_PASSES * RADIX_BUCKETS];
+            group.run([=] {
+                countDigits(arr+begin, end-begin, desc, table);
+            });
+        }
+        group.wait();
+    }
+
+    for (int c = 0; c < chunks; c++) {
+        const size_t* table = &partial[(size_t)c * RADIX_PASSES * RADIX_BUCKETS];
+
+        for (int i = 0; i < RADIX_PASSES * RADIX_BUCKETS; i++) {
+            counts[i / RADIX_BUCKETS][i % RADIX_BUCKETS] += table[i];
+        }
+    }
+}
+
+/**
+ * @brief Sorts the array in ascending order using LSD Radix sort algorithm.
+ *
+ * Sorts on 8-bit digits, least significant first, with one counting pass over the
+ * array for all digits and one scatter pass per digit. Passes in which every key
+ * has the same digit are skipped. Negative numbers are ordered by flipping the sign
+ * bit of each key. Runs in O(n) time with a single scratch buffer of @p length integers.
+ *
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param desc If true, sorts the array in descending order; otherwise, sorts it in ascending order. (default=false)
+ * @param num_threads Number of threads for the histogram pass. If non-positive, uses the number of hardware threads. (default=0)
+ *
+ * @note @p arr must be a non-null pointer, and @p length must be a non-negative integer.
+ * @note If the scratch buffer cannot be allocated, falls back to introSort.
+ *
+ * @code
+ * int arr[] = {5, -1, 2, -3, 4};
+ *
+ * radixSort(arr, 5);
+ * // Sorted array: -3 -1 2 4 5
+ *
+ * radixSort(arr, 5, true);
+ * // Sorted array: 5 4 2 -1 -3
+ * @endcode
+ */
+void radixSort(int arr[], const int length, const bool desc, const int num_threads) {
+    if (!arr) {
+        return;
+    }
+    if (length <= 0) {
+        return;
+    }
+
+    dsa::radixSort(std::span<int>(arr, length), desc, num_threads);
+}
+
+/**
+ * @brief Sorts the array in ascending order using LSD Radix sort algorithm.
+ *
+ * Same algorithm as radixSort, with 64-bit counts & offsets, so arrays of any length are supported.
+ *
+ * @param arr Array to sort.
+ * @param desc If true, sorts the array in descending order; otherwise, sorts it in ascending order. (default=false)
+ * @param num_threads Number of threads for the histogram pass. If non-positive, uses the number of hardware threads. (default=0)
+ *
+ * @note If the scratch buffer cannot be allocated, falls back to introSort.
+ */
+void dsa::radixSort(std::span<int> arr, const bool desc, const int num_threads) {
+    /*
+    Out-of-place LSD Radix sort.
+    */
+    const size_t length = arr.size();
+    if (length == 0) {
+        return;
+    }
+
+    ScratchArena& arena = threadScratchArena();
+    ScratchScope scope(arena);
+    int* scratch = arena.allocateArray<int>(length);
+
+    if (!scratch) {
+        dsa::introSort(arr, desc);
+        return;
+    }
+
+    size_t counts[RADIX_PASSES][RADIX_BUCKETS] = {};
+    buildHistograms(arr.data(), length, desc, num_threads, counts);
+
+    int* src = arr.data();
+    int* dst = scratch;
+
+    for (int pass = 0; pass < RADIX_PASSES; pass++) {
+        int shift = pass * RADIX_BITS;
+        uint32_t first_key = radixKey(src[0], desc);
+
+        // Every key has the same digit in this pass, so the scatter would not move anything.
+        if (counts[pass][(first_key >> shift) & (RADIX_BUCKETS-1)] == length) {
+            continue;
+        }
+
+        size_t offsets[RADIX_BUCKETS];
+        size_t sum = 0;
+
+        for (int b = 0; b < RADIX_BUCKETS; b++) {
+            offsets[b] = sum;
+            sum += counts[pass][b];
+        }
+
+        for (size_t i = 0; i < length; i++) {
+            uint32_t digit = (radixKey(src[i], desc) >> shift) & (RADIX_BUCKETS-1);
+            dst[offsets[digit]++] = src[i];
+        }
+
+        countMoves(length);
+        std::swap(src, dst);
+    }
+
+    if (src != arr.data()) {
+        std::memcpy(arr.data(), src, length * sizeof(int));
+        countMoves(length);
+    }
+}
@@ -0,0 +1,237 @@
+/**
+ * @file scratch_arena.cpp
+ * @brief Scratch arena - Reusable, huge-page-backed memory for sort scratch & copy buffers.
+ *
+ * Provides function definitions for ScratchArena & ScratchScope.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <sys/mman.h>
+#include "scratch_arena.h"
+
+
+/**
+ * @brief Rounds @p bytes up to a multiple of @p unit, a power of two.
+ */
+static size_t roundUp(const size_t bytes, const size_t unit) {
+    return (bytes + unit - 1) & ~(unit - 1);
+}
+
+/**
+ * @brief Creates an arena, optionally mapping its first block up front.
+ *
+ * @param reserve_bytes Bytes to map now, so the first sorts do not map memory. (default=0)
+ *
+ * @code
+ * ScratchArena arena(64 << 20); // Room for 16M ints of scratch before the arena has to grow
+ * @endcode
+ */
+ScratchArena::ScratchArena(size_t reserve_bytes) : current_(0), offset_(0) {
+    if (reserve_bytes > 0) {
+        mapBlock(reserve_bytes);
+    }
+}
+
+/**
+ * @brief Unmaps every block. Memory handed out by the arena must no longer be used.
+ */
+ScratchArena::~ScratchArena() {
+    unmapBlocks();
+}
+
+/**
+ * @brief Maps a new block of at least @p bytes at the end of the arena.
+ *
+ * Uses the reserved huge page pool when the system has one; otherwise maps ordinary pages
+ * aligned to a huge page boundary & asks for transparent huge pages, which the kernel
+ * grants on a best-effort basis.
+ *
+ * @return True, if the block was mapped; otherwise, false.
+ */
+bool ScratchArena::mapBlock(size_t bytes) {
+    if (bytes > SIZE_MAX - 2*ARENA_HUGE_PAGE_BYTES) {
+        return false;
+    }
+    bytes = roundUp(bytes, ARENA_HUGE_PAGE_BYTES);
+
+    size_t start = blocks_.empty() ? 0 : blocks_.back().start + blocks_.back().bytes;
+    void* map = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+    if (map != MAP_FAILED) {
+        blocks_.push_back({(char*)map, bytes, start, true});
+        return true;
+    }
+
+    // Over-map by one huge page & trim both ends, so the block starts on a huge page boundary.
+    size_t padded = bytes + ARENA_HUGE_PAGE_BYTES;
+    map = mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (map == MAP_FAILED) {
+        return false;
+    }
+
+    char* base = (char*)roundUp((uintptr_t)map, ARENA_HUGE_PAGE_BYTES);
+    size_t head = base - (char*)map;
+
+    if (head > 0) {
+        munmap(map, head);
+    }
+    if (padded - head > bytes) {
+        munmap(base + bytes, padded - head - bytes);
+    }
+
+    madvise(base, bytes, MADV_HUGEPAGE);
+    blocks_.push_back({base, bytes, start, false});
+    return true;
+}
+
+/**
+ * @brief Unmaps every block & empties the arena.
+ */
+void ScratchArena::unmapBlocks() {
+    for (const Block& block : blocks_) {
+        munmap(block.base, block.bytes);
+    }
+
+    blocks_.clear();
+    current_ = 0;
+    offset_ = 0;
+}
+
+/**
+ * @brief Allocates @p bytes of uninitialised memory aligned to ARENA_ALIGNMENT.
+ *
+ * Takes the memory from the current block when it fits, then from the blocks kept from
+ * earlier calls; maps a new block, at least as large as the whole arena, only when none fits.
+ *
+ * @param bytes Number of bytes.
+ *
+ * @return Pointer to the memory, valid until the arena is released to a mark taken before
+ *         this call; null, if a new block could not be mapped.
+ *
+ * @code
+ * ScratchArena& arena = threadScratchArena();
+ * ScratchScope scope(arena);
+ * int* scratch = arena.allocateArray<int>(length); // Released when scope ends
+ * @endcode
+ */
+void* ScratchArena::allocate(size_t bytes) {
+    if (bytes > SIZE_MAX - ARENA_ALIGNMENT) {
+        return nullptr;
+    }
+    bytes = roundUp(bytes > 0 ? bytes : 1, ARENA_ALIGNMENT);
+
+    for (; current_ < blocks_.size(); current_++) {
+        const Block& block = blocks_[current_];
+
+        if (offset_ < block.start) {
+            offset_ = block.start;
+        }
+        // The tail of a block that is too small is skipped, & reused after the next release.
+        if (block.start + block.bytes - offset_ >= bytes) {
+            void* ptr = block.base + (offset_ - block.start);
+            offset_ += bytes;
+            return ptr;
+        }
+    }
+
+    // Doubling the arena keeps the number of blocks, & of mmap calls, logarithmic in its peak size.
+    if (!mapBlock(bytes > capacity() ? bytes : capacity())) {
+        return nullptr;
+    }
+
+    current_ = blocks_.size() - 1;
+    offset_ = blocks_[current_].start + bytes;
+    return blocks_[current_].base;
+}
+
+/**
+ * @brief Returns the current end of the live allocations, to be passed to release.
+ */
+size_t ScratchArena::mark() const {
+    return offset_;
+}
+
+/**
+ * @brief Releases every allocation made after @p mark was taken; the memory stays mapped for reuse.
+ *
+ * When the arena becomes empty & is made of several blocks, they are replaced by one block
+ * of the same total size, so the next call that needs the peak amount finds it contiguous.
+ *
+ * @param mark Value returned by mark(). Marks must be released in reverse order.
+ */
+void ScratchArena::release(size_t mark) {
+    offset_ = mark;
+
+    while (current_ > 0 && (current_ == blocks_.size() || blocks_[current_].start > mark)) {
+        current_--;
+    }
+
+    if (offset_ == 0 && blocks_.size() > 1) {
+        size_t total = capacity();
+        unmapBlocks();
+        mapBlock(total);
+    }
+}
+
+/**
+ * @brief Unmaps the arena's memory if nothing is allocated from it, e.g. after an unusually large sort.
+ */
+void ScratchArena::trim() {
+    if (offset_ == 0) {
+        unmapBlocks();
+    }
+}
+
+/**
+ * @brief Returns the number of bytes in use, counting the skipped tails of full blocks.
+ */
+size_t ScratchArena::used() const {
+    return offset_;
+}
+
+/**
+ * @brief Returns the number of bytes mapped by the arena.
+ */
+size_t ScratchArena::capacity() const {
+    return blocks_.empty() ? 0 : blocks_.back().start + blocks_.back().bytes;
+}
+
+/**
+ * @brief Returns the number of bytes mapped from the reserved huge page pool.
+ *
+ * @note Blocks that fell back to transparent huge pages are not counted; whether the kernel
+ *       backed them with huge pages shows in AnonHugePages in /proc/self/smaps.
+ */
+size_t ScratchArena::hugePageBytes() const {
+    size_t bytes = 0;
+
+    for (const Block& block : blocks_) {
+        if (block.huge) {
+            bytes += block.bytes;
+        }
+    }
+
+    return bytes;
+}
+
+/**
+ * @brief Marks the arena, releasing everything allocated from it in this scope on destruction.
+ */
+ScratchScope::ScratchScope(ScratchArena& arena) : arena_(arena), mark_(arena.mark()) {}
+
+ScratchScope::~ScratchScope() {
+    arena_.release(mark_);
+}
+
+/**
+ * @brief Returns the calling thread's arena, which lives until the thread exits.
+ *
+ * The sorting functions take their scratch buffers from it, so a thread that sorts
+ * repeatedly maps memory only while its largest input grows.
+ */
+ScratchArena& threadScratchArena() {
+    static thread_local ScratchArena arena;
+    return arena;
+}
@@ -0,0 +1,91 @@
+/**
+ * @file scratch_arena.h
+ * @brief Scratch arena - Reusable, huge-page-backed memory for sort scratch & copy buffers.
+ *
+ * A ScratchArena hands out memory by bumping an offset & takes it back by resetting the
+ * offset to an earlier mark, so allocations are released in reverse order (use a
+ * ScratchScope). The memory is mapped in blocks of whole 2 MiB huge pages & kept across
+ * calls: once the arena has grown to the largest working set, sorting maps no more memory
+ * & never calls the heap. Each thread has its own arena, threadScratchArena().
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Size of a huge page; blocks are whole multiples of it.
+static const size_t ARENA_HUGE_PAGE_BYTES = (size_t)2 << 20;
+// Alignment of every allocation: one cache line, & enough for any SIMD load.
+static const size_t ARENA_ALIGNMENT = 64;
+
+class ScratchArena {
+public:
+    explicit ScratchArena(size_t reserve_bytes = 0);
+    ~ScratchArena();
+
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    void* allocate(size_t bytes);
+    template <typename T> T* allocateArray(size_t count);
+
+    size_t mark() const;
+    void release(size_t mark);
+    void trim();
+
+    size_t used() const;
+    size_t capacity() const;
+    size_t hugePageBytes() const;
+
+private:
+    struct Block {
+        char* base;
+        size_t bytes;
+        size_t start;   // Offset of the block in the arena's address space.
+        bool huge;      // Mapped from the reserved huge page pool (MAP_HUGETLB).
+    };
+
+    bool mapBlock(size_t bytes);
+    void unmapBlocks();
+
+    std::vector<Block> blocks_;
+    size_t current_;    // Block that holds offset_.
+    size_t offset_;     // End of the live allocations, in the arena's address space.
+};
+
+class ScratchScope {
+public:
+    explicit ScratchScope(ScratchArena& arena);
+    ~ScratchScope();
+
+    ScratchScope(const ScratchScope&) = delete;
+    ScratchScope& operator=(const ScratchScope&) = delete;
+
+private:
+    ScratchArena& arena_;
+    size_t mark_;
+};
+
+ScratchArena& threadScratchArena();
+
+
+/**
+ * @brief Allocates an uninitialised array of @p count elements of a trivially copyable type.
+ *
+ * @return Pointer to the array; null, if the memory could not be mapped or the size overflows.
+ */
+template <typename T>
+T* ScratchArena::allocateArray(size_t count) {
+    static_assert(alignof(T) <= ARENA_ALIGNMENT, "Arena allocations are only 64-byte aligned");
+
+    if (count > SIZE_MAX / sizeof(T)) {
+        return nullptr;
+    }
+
+    return static_cast<T*>(allocate(count * sizeof(T)));
+}
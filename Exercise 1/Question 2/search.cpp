@@ -1,64 +1,87 @@
 /**
  * @file search.cpp
- * @brief Implementation of Linear Search and Binary Search algorithms.
+ * @brief Program to search a user-defined array - Linear Search, Binary Search, Hash Search, Interpolation Search, Exponential Search.
  * 
  * @author Abdullah Sheriff
  * @date Februrary 8th, 2025
  */
 
+#include <cstring>
 #include <iostream>
+#include <new>
+#include "array_file.h"
+#include "io.h"
 #include "sort.h"
+#include "search.h"
+#include "sort_stats.h"
 
 using std::cin;
 using std::cout;
+using std::cerr;
 using std::endl;
 
-using std::numeric_limits; using std::streamsize; // For handling input exceptions
 using std::bad_alloc;
 
-// ====== Utilities ======
-bool isInvalidInput();
-int isSorted(const int [], const int, const bool);
-
-// ====== Array Utilities ======
-int getArrayLengthInput();
-int* getArrayInput(const int);
-int* deepCopyArray(const int[], const int);
-
-// ====== Input Utilities ======
-int getIntegerInput();
-
-// ====== Printing Utilities ======
-void printArray(const int[], const int);
-
-// ====== Searching Functions ======
-int binarySearch(const int, const int [], const int);
-int linearSearch(const int, const int [], const int);
-
+/**
+ * @brief Search of a sorted array selectable from the command line.
+ */
+struct SortedSearch {
+    const char* cli_name;
+    int (*search)(const int, const SortedView&);
+};
+
+// ====== Batch Mode ======
+int runBatchSearch(int, char*[]);
+static const SortedSearch* findSortedSearch(const char*);
+
+static const SortedSearch SORTED_SEARCHES[] = {
+    {"binary", binarySearch},
+    {"interpolation", interpolationSearch},
+    {"exponential", exponentialSearch},
+};
+
+static const char* const BATCH_OPTIONS[] = {"algo", "input", "queries", "output", "sort-queries", "binary", "stats", nullptr};
+
+
+/*
+Usage:
+    search                                  Interactive menu.
+    search --algo=linear|binary|hash|interpolation|exponential --input=FILE --queries=FILE [--output=FILE] [--binary] [--sort-queries] [--stats]
+           FILE: whitespace-separated integers, or an array file (see array_file.h)
+*/
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        return runBatchSearch(argc, argv);
+    }
 
-int main() {
     int length, value, idx;
     unsigned int user_choice;
     int* arr; int* arr_copy;
+    SortedView view;
+    // Built on the first hash search; the array does not change during the session.
+    HashIndex hash_index = {};
 
     length = getArrayLengthInput();
     arr = getArrayInput(length);
+    // One copy buffer for the whole session; the searches of a sorted array refresh it before sorting it.
+    arr_copy = deepCopyArray(arr, length);
     cout << endl;
     
     do {
-        arr_copy = deepCopyArray(arr, length);
-
         cout << "1. Linear Search" << endl;
         cout << "2. Binary Search" << endl;
-        cout << "3. Exit" << endl;
+        cout << "3. Hash Search" << endl;
+        cout << "4. Interpolation Search" << endl;
+        cout << "5. Exponential Search" << endl;
+        cout << "6. Exit" << endl;
         cout << endl;
 
         do {
-            cout << "Enter your choice (1-3): ";
+            cout << "Enter your choice (1-6): ";
             cin >> user_choice;
 
-            if (isInvalidInput() || user_choice < 1 || user_choice > 3) {
-                cout << "Invalid input. Please enter an integer between (1-3)." << endl;
+            if (isInvalidInput() || user_choice < 1 || user_choice > 6) {
+                cout << "Invalid input. Please enter an integer between (1-6)." << endl;
             }
             else {
                 break;
@@ -84,14 +107,19 @@ int main() {
                 break;
 
             case 2:
+            case 4:
+            case 5:
+                copyArray(arr_copy, arr, length);
                 printArray(arr_copy, length);
-                cout << "Sorting the array. Binary search requires a sorted array." << endl;
-                selectionSort(arr_copy, length);
+                cout << "Sorting the array. Binary, interpolation & exponential search require a sorted array." << endl;
+                view = sortToView(arr_copy, length);
                 printArray(arr_copy, length);
                 cout << endl;
 
                 value = getIntegerInput();
-                idx = binarySearch(value, arr_copy, length);
+                idx = user_choice == 2 ? binarySearch(value, view)
+                    : user_choice == 4 ? interpolationSearch(value, view)
+                                       : exponentialSearch(value, view);
 
                 if (idx >= 0) {
                     cout << value << " found at index " << idx << endl;
@@ -102,12 +130,35 @@ int main() {
                 else if (idx == -2) {
                     cout << "Error: Invalid input. The array is either null or length is a non-positive integer." << endl;
                 }
-                else if (idx == -3) {
-                    cout << "Error: Invalid input. The array is not sorted in ascending order." << endl;
-                }
                 cout << endl;
                 break;
+
             case 3:
+                if (!hash_index.control && buildHashIndex(arr, length, &hash_index) == -4) {
+                    cout << "Error: Out of memory." << endl;
+                    cout << endl;
+                    break;
+                }
+
+                value = getIntegerInput();
+                idx = hashSearch(value, &hash_index);
+
+                if (idx >= 0) {
+                    cout << value << " found at index " << idx << endl;
+                }
+                else if (idx == -1) {
+                    cout << value << " not found." << endl;
+                }
+                else if (idx == -2) {
+                    cout << "Error: Invalid input. The array is either null or length is a non-positive integer." << endl;
+                }
+                cout << endl;
+                break;
+
+            case 6:
+                freeHashIndex(&hash_index);
+                delete[] arr;
+                delete[] arr_copy;
                 return 0;
                 break;
         }
@@ -117,319 +168,156 @@ int main() {
 }
 
 /**
- * @brief Checks whether the previous input was invalid.
+ * @brief Searches for every integer of a queries file in the integers of an input file.
  * 
- * @return True, if the input is invalid; otherwise, false.
+ * Writes one result per query, in query order: the index found, or -1. Binary,
+ * interpolation & exponential search sort the input with radixSort first & report
+ * indices into the sorted array, like the interactive menu. Hash search builds a HashIndex of the input instead & reports
+ * the index of the first occurrence in the input, like linear search. Either file may be an array file, which is memory-mapped
+ * instead of parsed; an input array file with the sorted flag set is searched as is,
+ * without sorting or checking it. --binary writes the results as an array file. --stats
+ * prints the time & hardware counters of the searches to stderr; see sort_stats.h.
  * 
- * @code
- * int num;
- * std::cin >> num;
- * 
- * if (isInvalidInput()) {
- *      std::cout << "Invalid input. Please enter a valid integer." << std::endl;
- * }
- * @endcode
- */
-bool isInvalidInput() {
-    if (cin.fail()) {
-        // Handle datatype mismatch
-        cin.clear();
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
-        return true;
-    } else if (cin.peek() != '\n') {
-        // Handle extra inputs
-        cin.ignore(numeric_limits<streamsize>::max(), '\n');
-        return true;
-    }
-    else {
-        return false;
-    }
-}
-
-/**
- * @brief Checks whether the array is sorted or not.
+ * @param argc, argv Arguments passed to main.
  * 
- * @param arr Pointer to the array.
- * @param length Number of elements in the array.
- * @param desc If true, checks whether the array is sorted in descending order; otherwise, ascending order.
- * 
- * @return Index of the maximum element in the array.
- * @return -2, if @p arr is null or if @p length is a non-negative integer.
+ * @return 0, if every query was answered; otherwise, 1 after printing an error to stderr.
  * 
  * @code
- * int arr[] = {5, 1, 2, 3, 4};
- * int sorted_arr[] = {1, 2, 3, 4, 5};
- * 
- * isSorted(arr, 5); // Returns 0
- * isSorted(sorted_arr, 5); // Returns 1
- * isSorted(sorted_arr, 5, true); // Returns 0
+ * // ./search --algo=binary --input=data.txt --queries=queries.txt --output=results.txt
+ * // ./search --algo=binary --input=sorted.bin --queries=queries.bin --output=results.bin --binary
+ * // ./search --algo=hash --input=data.bin --queries=queries.bin --output=results.txt
+ * // ./search --algo=interpolation --input=timestamps.bin --queries=queries.txt
  * @endcode
  */
-int isSorted(const int arr[], const int length, const bool desc=false) {
-    if (arr == NULL) {
-        return -2;
+int runBatchSearch(int argc, char* argv[]) {
+    const char* unknown = findUnknownOption(argc, argv, BATCH_OPTIONS);
+    const char* algo = getOption(argc, argv, "algo");
+    const char* input = getOption(argc, argv, "input");
+    const char* queries_path = getOption(argc, argv, "queries");
+    const char* output = getOption(argc, argv, "output");
+
+    if (unknown) {
+        cerr << "Error: Unknown option " << unknown << "." << endl;
+        return 1;
     }
-    if (length <= 0) {
-        return -2;
+    if (!algo || !input || !queries_path || (std::strcmp(algo, "linear") != 0 && std::strcmp(algo, "hash") != 0
+                                             && !findSortedSearch(algo))) {
+        cerr << "Usage: " << argv[0] << " --algo=linear|binary|hash|interpolation|exponential --input=FILE --queries=FILE [--output=FILE] [--binary] [--sort-queries] [--stats]" << endl;
+        return 1;
     }
 
-    for (int i = 1; i < length; i++) {
-        if (desc ? arr[i] > arr[i-1] : arr[i] < arr[i-1]) return 0;
-    }
-
-    return 1;
-}
-
-/**
- * @brief Returns a value for length of an array and validates input.
- * 
- * @code
- * int length = getArrayLengthInput();
- * 
- * // Output: "Enter a positive array length: 5" 
- * // Returns 5
- * @endcode
- */
-int getArrayLengthInput() {
-    int length;
-
-    do {
-        cout << "Enter a positive array length: ";
-        cin >> length;
+    MappedArray arr, queries;
+    int* results;
 
-        if (isInvalidInput() || length < 1) {
-            cout << "Invalid input. Please enter a valid integer greater than (0)." << endl;
-        }
-        else {
-            return length;
-        }
-    } while (true);
-}
-
-/**
- * @brief Returns an array and validates its elements.
- * 
- * @param length Number of elements in the array.
- * 
- * @note @p length must be a non-negative integer.
- * 
- * @code
- * int length = 5;
- * int* arr = getArrayInput(length);
- * 
- * // Output: "Enter 5 integers separated by spaces: 5 4 3 2 1" 
- * // Returns {5, 4, 3, 2, 1}
- * @endcode
- */
-int* getArrayInput(const int length) {
-    if (length <= 0) {
-        return nullptr;
+    // Copy-on-write: a sorted array file is never written, so its pages are shared with the page cache.
+    if (loadIntegerArray(input, ARRAY_FILE_PRIVATE, &arr) != 0 || arr.length == 0) {
+        cerr << "Error: Could not read integers from " << input << "." << endl;
+        return 1;
+    }
+    if (loadIntegerArray(queries_path, ARRAY_FILE_READ, &queries) != 0) {
+        cerr << "Error: Could not read integers from " << queries_path << "." << endl;
+        closeArrayFile(&arr);
+        return 1;
     }
 
-    int* arr;
+    const int num_queries = queries.length;
 
     try {
-        arr = new int[length];
+        results = new int[num_queries > 0 ? num_queries : 1];
     } catch (const bad_alloc& e) {
-        return nullptr;
+        cerr << "Error: Out of memory." << endl;
+        closeArrayFile(&arr);
+        closeArrayFile(&queries);
+        return 1;
     }
 
-    do {
-        cout << "Enter " << length << " integers separated by spaces: ";
-
-        for (int i = 0; i < length; i++) {
-            cin >> arr[i];
-        }
+    const bool show_stats = hasFlag(argc, argv, "stats");
+    SortStats stats;
 
-        if (isInvalidInput()) {
-            cout << "Invalid input. Enter only " << length << " integers separated by spaces." << endl;
+    if (std::strcmp(algo, "linear") == 0) {
+        if (show_stats) {
+            beginStats();
         }
-        else {
-            return arr;
+        for (int i = 0; i < num_queries; i++) {
+            results[i] = linearSearch(queries.data[i], arr.data, arr.length);
         }
-    } while (true);
-}
-
-/**
- * @brief Returns a copy of an array. 
- * 
- * @param arr Pointer to the array.
- * @param length Number of elements in the array.
- * 
- * @return Pointer to a copy of the array.
- * 
- * @note @p arr must be a non-null pointer, and @p length must be a non-negative integer.
- * 
- * @code
- * int arr[] = {5, 1, 2, 3, 4};
- * int arr_copy = deepCopyArray(arr, 5); // arr_copy = {5, 1, 2, 3, 4}
- * @endcode
- */
-int* deepCopyArray(const int arr[], const int length) {
-    if (!arr) {
-        return nullptr;
-    }
-    if (length <= 0) {
-        return nullptr;
-    }
-
-    int* arr_copy;
-
-    try {
-        arr_copy = new int[length];
-    } catch (const bad_alloc& e) {
-        return nullptr;
     }
+    else if (std::strcmp(algo, "hash") == 0 && num_queries > 0) {
+        HashIndex index;
+
+        if (buildHashIndex(arr.data, arr.length, &index) != 0) {
+            cerr << "Error: Out of memory." << endl;
+            closeArrayFile(&arr);
+            closeArrayFile(&queries);
+            delete[] results;
+            return 1;
+        }
 
-    for (int i = 0; i < length; i++) {
-        arr_copy[i] = arr[i];
+        // As for binary search, the stats cover the lookups only, not the build before them.
+        if (show_stats) {
+            beginStats();
+        }
+        for (int i = 0; i < num_queries; i++) {
+            results[i] = hashSearch(queries.data[i], &index);
+        }
+        freeHashIndex(&index);
     }
+    else if (num_queries > 0) {
+        // Does nothing if the array file's sorted flag is already set.
+        sortArrayFile(&arr, [](int a[], const int n, bool desc) { radixSort(a, n, desc); });
 
-    return arr_copy;
-}
-
-/**
- * @brief Prompts the user for integer input and validates it.
- * 
- * @return Integer entered by the user.
- * 
- * @code
- * int value = getIntegerInput();
- * std::cout << "You entered: " << value << std::endl;
- * @endcode
- */
-int getIntegerInput() {
-    int value;
-
-    do {
-        cout << "Enter an integer: ";
-        cin >> value;
+        SortedView view;
+        viewArrayFile(&arr, &view);
 
-        if (isInvalidInput()) {
-            cout << "Invalid input. Please enter a valid integer." << endl;
+        // The stats cover the searches only, not the sort before them.
+        if (show_stats) {
+            beginStats();
+        }
+        if (std::strcmp(algo, "binary") == 0) {
+            binarySearchBatch(queries.data, num_queries, view, results, hasFlag(argc, argv, "sort-queries"));
         }
         else {
-            return value;
+            const SortedSearch* sorted_search = findSortedSearch(algo);
+            for (int i = 0; i < num_queries; i++) {
+                results[i] = sorted_search->search(queries.data[i], view);
+            }
         }
-    } while (true);
-}
-
-/**
- * @brief Prints the elements in an array.
- * 
- * @param arr Pointer to the array.
- * @param length Number of elements in the array.
- * 
- * @note @p arr must be a non-null pointer, and @p length must be a non-negative integer.
- * 
- * @code
- * int arr[] = {5, 1, 2, 3, 4};
- * printArray(arr, 5) // Output: "Array elements: 5 1 2 3 4"
- * @endcode
- */
-void printArray(const int arr[], const int length) {
-    if (!arr) {
-        return;
-    }
-    if (length < 0) {
-        return;
     }
-    if (length == 0) {
-        cout << "Array is empty." << endl;
+    else if (show_stats) {
+        beginStats();
     }
 
-    cout << "Array elements: ";
-
-    for (int i = 0; i < length; i++) {
-        cout << arr[i] << ' ';
+    if (show_stats) {
+        endStats(&stats);
+        printStats(&stats);
     }
-    cout << endl;
-}
 
-/**
- * @brief Returns the index of the first occurrence of an element in the array using linear search algorithm.
- * 
- * @param value Number to be searched in the array.
- * @param arr Pointer to the array.
- * @param length Number of elements in the array.
- * 
- * @return Index of @p value in the array, if found; otherwise, -1.
- * @return -2, if @p arr is null or if @p length is a non-negative integer.
- * 
- * @code
- * int arr[] = {5, 1, 2, 3, 4};
- * 
- * linearSearch(3, arr, 5); // Returns 3
- * linearSearch(6, arr, 5); // Returns -1
- * @endcode
- */
-int linearSearch(const int value, const int arr[], const int length) {
-    if (arr == NULL) {
-        return -2;
-    }
-    if (length <= 0) {
-        return -2;
+    const char* path = output ? output : "-";
+    int status = hasFlag(argc, argv, "binary") ? writeArrayFile(path, results, num_queries)
+                                               : writeIntegerFile(path, results, num_queries);
+    if (status != 0) {
+        cerr << "Error: Could not write the results." << endl;
     }
 
-    for (int i = 0; i < length; i++) {
-        if (arr[i] == value) return i;
-    }
-
-    return -1;
+    closeArrayFile(&arr);
+    closeArrayFile(&queries);
+    delete[] results;
+    return status == 0 ? 0 : 1;
 }
 
 /**
- * @brief Returns the index of the first occurrence of an element in the array using binary search algorithm.
- * 
- * @param value Number to be searched in the array.
- * @param arr Pointer to the array.
- * @param length Number of elements in the array.
+ * @brief Returns the search of a sorted array named by --algo.
  * 
- * @return Index of @p value in the array, if found; otherwise, -1.
- * @return -2, if @p arr is null or if @p length is a non-negative integer.
- * @return -3, if @p arr is not sorted in ascending order.
+ * @param algo "binary", "interpolation" or "exponential".
  * 
- * @code
- * int arr[] = {5, 1, 2, 3, 4};
- * int sorted_arr[] = {1, 2, 3, 4, 5};
- * 
- * binarySearch(3, arr, 5); // Returns -3
- * binarySearch(2, sorted_arr, 5); // Returns 1
- * binarySearch(6, sorted_arr, 5); // Returns -1
- * @endcode
+ * @return Pointer into SORTED_SEARCHES; nullptr, if @p algo names none of them.
  */
-int binarySearch(const int value, const int arr[], const int length) {
-    if (arr == NULL) {
-        return -2;
-    }
-    if (length <= 0) {
-        return -2;
-    }
-    if (!isSorted(arr, length)) {
-        return -3;
-    }
-
-    if (value > arr[length-1] || value < arr[0]) {
-        return -1;
-    }
-
-    int left_idx, mid_idx, right_idx;
-    left_idx = 0;
-    right_idx = length - 1;
-
-    do {
-        mid_idx = left_idx + ((right_idx - left_idx) / 2);
-
-        if (arr[mid_idx] == value) {
-            return mid_idx;
-        }
-        else if (arr[mid_idx] > value) {
-            right_idx = mid_idx - 1;
+static const SortedSearch* findSortedSearch(const char* algo) {
+    for (const SortedSearch& sorted_search : SORTED_SEARCHES) {
+        if (std::strcmp(algo, sorted_search.cli_name) == 0) {
+            return &sorted_search;
         }
-        else if (arr[mid_idx] < value) {
-            left_idx = mid_idx + 1;
-        }
-    } while (left_idx <= right_idx);
+    }
 
-    return -1;
+    return nullptr;
 }
@@ -0,0 +1,107 @@
+/**
+ * @file search.h
+ * @brief Searching algorithms - Linear Search, Binary Search, Batched Binary Search, Branchless Binary Search, Range Queries, Interpolation Search, Exponential Search, Eytzinger Search, Static Search Tree, Hash Index.
+ * 
+ * Provides function declarations for searching algorithms.
+ * 
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#pragma once
+
+#include "sorted_view.h"
+
+/**
+ * @brief Sorted array stored in Eytzinger (BFS) order for cache-friendly binary search.
+ * 
+ * keys[1..length] holds the tree level by level; keys[0] is unused so that the
+ * children of node k sit at 2k & 2k+1. ranks[k] is the index keys[k] had in the sorted array.
+ */
+struct EytzingerIndex {
+    int* keys;
+    int* ranks;
+    int length;
+};
+
+// Most layers a StaticTreeIndex has: 2^31 keys fill 2^27 leaves, & each layer above has 17 times fewer nodes.
+static const int STATIC_TREE_MAX_HEIGHT = 8;
+
+/**
+ * @brief Sorted array stored as a static B+-tree (S+-tree) of 16-key nodes, each filling one cache line.
+ * 
+ * The leaf layer is the sorted array itself, padded with INT_MAX to whole nodes, so a
+ * position in it is an index into the sorted array. Each layer above has one node per 17
+ * nodes below it; key i of a node is the smallest key under its child i+1. A search reads
+ * one node per layer & picks the child by counting the node's keys below the value with SIMD.
+ */
+struct StaticTreeIndex {
+    int* keys;                                   // Every layer, leaves first, in one 64-byte aligned block.
+    const int* layers[STATIC_TREE_MAX_HEIGHT];   // layers[0] is the leaves; layers[height-1] is the root node.
+    int height;
+    int length;
+};
+
+/**
+ * @brief Open-addressing hash table (Swiss-table style) from the values of an array to the index of their first occurrence.
+ * 
+ * Slots come in groups of 16 whose keys fill one cache line. Each slot also has a control
+ * byte holding 7 bits of its key's hash, or 0x80 if it is empty, so one SIMD compare of a
+ * group's 16 control bytes finds the few slots worth comparing keys with. The table is
+ * at most 7/8 full, so every probe sequence reaches a group with an empty slot.
+ */
+struct HashIndex {
+    unsigned char* control;   // 16 bytes per group.
+    int* keys;                // 16 keys per group, one cache line.
+    int* ranks;               // ranks[s] is the index of the first occurrence of keys[s] in the array.
+    int groups;               // Number of groups, a power of two.
+    int length;               // Number of elements of the array the index was built from.
+};
+
+// ====== Utilities ======
+int isSorted(const int[], const int, const bool desc=false);
+
+// ====== Searching Functions ======
+int linearSearch(const int, const int[], const int);
+int linearSearchCount(const int, const int[], const int);
+int linearSearchAll(const int, const int[], const int, int[], const int);
+int binarySearch(const int, const int[], const int);
+int binarySearch(const int, const SortedView&);
+int binarySearchBatch(const int[], const int, const int[], const int, int[], const bool sort_queries=false);
+int binarySearchBatch(const int[], const int, const SortedView&, int[], const bool sort_queries=false);
+int binarySearchBatchInterleaved(const int[], const int, const SortedView&, int[], const bool sort_queries=false);
+int branchlessLowerBound(const int, const int[], const int);
+int branchlessBinarySearch(const int, const int[], const int);
+
+// ====== Range Queries ======
+int lowerBound(const int, const int[], const int);
+int lowerBound(const int, const SortedView&);
+int upperBound(const int, const int[], const int);
+int upperBound(const int, const SortedView&);
+int equalRange(const int, const int[], const int, int*, int*);
+int equalRange(const int, const SortedView&, int*, int*);
+int countInRange(const int, const int, const int[], const int);
+int countInRange(const int, const int, const SortedView&);
+
+// ====== Interpolation & Exponential Search ======
+int interpolationSearch(const int, const int[], const int);
+int interpolationSearch(const int, const SortedView&);
+int exponentialSearch(const int, const int[], const int);
+int exponentialSearch(const int, const SortedView&);
+
+// ====== Eytzinger Layout ======
+int buildEytzingerIndex(const int[], const int, EytzingerIndex*);
+void freeEytzingerIndex(EytzingerIndex*);
+int eytzingerSearch(const int, const EytzingerIndex*);
+
+// ====== Static Search Tree ======
+int buildStaticTreeIndex(const int[], const int, StaticTreeIndex*);
+int buildStaticTreeIndex(const SortedView&, StaticTreeIndex*);
+void freeStaticTreeIndex(StaticTreeIndex*);
+int staticTreeSearch(const int, const StaticTreeIndex*);
+int staticTreeLowerBound(const int, const StaticTreeIndex*);
+
+// ====== Hash Index ======
+int buildHashIndex(const int[], const int, HashIndex*);
+void freeHashIndex(HashIndex*);
+int hashSearch(const int, const HashIndex*);
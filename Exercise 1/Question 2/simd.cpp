@@ -0,0 +1,791 @@
+/**
+ * @file simd.cpp
+ * @brief SIMD kernels with runtime CPU dispatch - Min/Max index reductions, Equality scans, Rank scans, Search tree descent.
+ *
+ * Provides function definitions for the kernels declared in simd.h.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include "simd.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define SIMD_X86 1
+#include <immintrin.h>
+#else
+#define SIMD_X86 0
+#endif
+
+enum SimdLevel { SIMD_SCALAR, SIMD_SSE41, SIMD_AVX2 };
+
+// ====== Dispatch ======
+static SimdLevel detectSimdLevel();
+static SimdLevel simdLevel();
+const char* simdLevelName();
+
+// ====== Reductions ======
+int simdMinIdx(const int[], const int);
+int simdMaxIdx(const int[], const int);
+void simdMinMaxIdx(const int[], const int, int*, int*);
+
+// ====== Equality Scans ======
+int simdFindFirst(const int, const int[], const int);
+int simdCountEqual(const int, const int[], const int);
+int simdFindAll(const int, const int[], const int, int[], const int);
+
+// ====== Rank Scans ======
+int simdCountLess(const int, const int[], const int);
+int simdCountLessEqual(const int, const int[], const int);
+
+// ====== Search Tree Descent ======
+size_t simdTreeLowerBound(const int, const int* const[], const int);
+
+
+/**
+ * @brief Returns the widest instruction set supported by the CPU & the compiler.
+ */
+static SimdLevel detectSimdLevel() {
+#if SIMD_X86
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx2")) {
+        return SIMD_AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1")) {
+        return SIMD_SSE41;
+    }
+#endif
+    return SIMD_SCALAR;
+}
+
+/**
+ * @brief Returns the instruction set used by the kernels, detected once on the first call.
+ */
+static SimdLevel simdLevel() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+/**
+ * @brief Returns the name of the instruction set used by the kernels.
+ *
+ * @code
+ * std::cout << simdLevelName() << std::endl; // "avx2"
+ * @endcode
+ */
+const char* simdLevelName() {
+    switch (simdLevel()) {
+        case SIMD_AVX2:
+            return "avx2";
+        case SIMD_SSE41:
+            return "sse4.1";
+        default:
+            return "scalar";
+    }
+}
+
+/**
+ * @brief Finds the first minimum &/or the first maximum of arr[0..length) one element at a time.
+ *
+ * @tparam WANT_MIN Whether to compute @p min_idx.
+ * @tparam WANT_MAX Whether to compute @p max_idx.
+ *
+ * @param arr Pointer to a non-empty array.
+ * @param length Number of elements in the array.
+ * @param min_idx, max_idx Receive the indices of the first minimum & first maximum.
+ */
+template <bool WANT_MIN, bool WANT_MAX>
+static void minMaxIdxScalar(const int arr[], const int length, int* min_idx, int* max_idx) {
+    int lo = 0;
+    int hi = 0;
+
+    for (int i = 1; i < length; i++) {
+        if (WANT_MIN && arr[i] < arr[lo]) {
+            lo = i;
+        }
+        if (WANT_MAX && arr[i] > arr[hi]) {
+            hi = i;
+        }
+    }
+
+    if (WANT_MIN) *min_idx = lo;
+    if (WANT_MAX) *max_idx = hi;
+}
+
+/**
+ * @brief Reduces per-lane winners to the overall winner, preferring the smallest index on ties.
+ *
+ * @param values, indices Best value of every lane & the index it was first seen at.
+ * @param lanes Number of lanes.
+ * @param want_min If true, the smallest value wins; otherwise, the largest.
+ * @param value, idx Receive the winning value & index.
+ */
+static void reduceLanes(const int values[], const int indices[], const int lanes, const bool want_min,
+                        int* value, int* idx) {
+    int best = 0;
+
+    for (int l = 1; l < lanes; l++) {
+        bool better = want_min ? values[l] < values[best] : values[l] > values[best];
+
+        if (better || (values[l] == values[best] && indices[l] < indices[best])) {
+            best = l;
+        }
+    }
+
+    *value = values[best];
+    *idx = indices[best];
+}
+
+#if SIMD_X86
+
+/**
+ * @brief Finds the first minimum &/or maximum of arr[0..length) eight lanes at a time with AVX2.
+ *
+ * Every lane keeps its best value & the index where it first saw it; strict compares
+ * keep the earliest index within a lane, and the final reduction prefers the smallest
+ * index across lanes, so ties resolve to the first occurrence like the scalar loop.
+ */
+template <bool WANT_MIN, bool WANT_MAX>
+__attribute__((target("avx2")))
+static void minMaxIdxAvx2(const int arr[], const int length, int* min_idx, int* max_idx) {
+    if (length < 16) {
+        minMaxIdxScalar<WANT_MIN, WANT_MAX>(arr, length, min_idx, max_idx);
+        return;
+    }
+
+    const __m256i step = _mm256_set1_epi32(8);
+    __m256i idx = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    __m256i lo = _mm256_loadu_si256((const __m256i*)arr);
+    __m256i hi = lo;
+    __m256i lo_idx = idx;
+    __m256i hi_idx = idx;
+
+    int i = 8;
+    for (; i + 8 <= length; i += 8) {
+        idx = _mm256_add_epi32(idx, step);
+        __m256i v = _mm256_loadu_si256((const __m256i*)(arr+i));
+
+        if (WANT_MIN) {
+            __m256i lt = _mm256_cmpgt_epi32(lo, v);
+            lo = _mm256_blendv_epi8(lo, v, lt);
+            lo_idx = _mm256_blendv_epi8(lo_idx, idx, lt);
+        }
+        if (WANT_MAX) {
+            __m256i gt = _mm256_cmpgt_epi32(v, hi);
+            hi = _mm256_blendv_epi8(hi, v, gt);
+            hi_idx = _mm256_blendv_epi8(hi_idx, idx, gt);
+        }
+    }
+
+    alignas(32) int values[8];
+    alignas(32) int indices[8];
+    int value;
+
+    if (WANT_MIN) {
+        _mm256_store_si256((__m256i*)values, lo);
+        _mm256_store_si256((__m256i*)indices, lo_idx);
+        reduceLanes(values, indices, 8, true, &value, min_idx);
+
+        for (int j = i; j < length; j++) {
+            if (arr[j] < value) { value = arr[j]; *min_idx = j; }
+        }
+    }
+    if (WANT_MAX) {
+        _mm256_store_si256((__m256i*)values, hi);
+        _mm256_store_si256((__m256i*)indices, hi_idx);
+        reduceLanes(values, indices, 8, false, &value, max_idx);
+
+        for (int j = i; j < length; j++) {
+            if (arr[j] > value) { value = arr[j]; *max_idx = j; }
+        }
+    }
+}
+
+/**
+ * @brief Finds the first minimum &/or maximum of arr[0..length) four lanes at a time with SSE4.1.
+ *
+ * Same lane scheme as minMaxIdxAvx2.
+ */
+template <bool WANT_MIN, bool WANT_MAX>
+__attribute__((target("sse4.1")))
+static void minMaxIdxSse41(const int arr[], const int length, int* min_idx, int* max_idx) {
+    if (length < 8) {
+        minMaxIdxScalar<WANT_MIN, WANT_MAX>(arr, length, min_idx, max_idx);
+        return;
+    }
+
+    const __m128i step = _mm_set1_epi32(4);
+    __m128i idx = _mm_setr_epi32(0, 1, 2, 3);
+    __m128i lo = _mm_loadu_si128((const __m128i*)arr);
+    __m128i hi = lo;
+    __m128i lo_idx = idx;
+    __m128i hi_idx = idx;
+
+    int i = 4;
+    for (; i + 4 <= length; i += 4) {
+        idx = _mm_add_epi32(idx, step);
+        __m128i v = _mm_loadu_si128((const __m128i*)(arr+i));
+
+        if (WANT_MIN) {
+            __m128i lt = _mm_cmpgt_epi32(lo, v);
+            lo = _mm_blendv_epi8(lo, v, lt);
+            lo_idx = _mm_blendv_epi8(lo_idx, idx, lt);
+        }
+        if (WANT_MAX) {
+            __m128i gt = _mm_cmpgt_epi32(v, hi);
+            hi = _mm_blendv_epi8(hi, v, gt);
+            hi_idx = _mm_blendv_epi8(hi_idx, idx, gt);
+        }
+    }
+
+    alignas(16) int values[4];
+    alignas(16) int indices[4];
+    int value;
+
+    if (WANT_MIN) {
+        _mm_store_si128((__m128i*)values, lo);
+        _mm_store_si128((__m128i*)indices, lo_idx);
+        reduceLanes(values, indices, 4, true, &value, min_idx);
+
+        for (int j = i; j < length; j++) {
+            if (arr[j] < value) { value = arr[j]; *min_idx = j; }
+        }
+    }
+    if (WANT_MAX) {
+        _mm_store_si128((__m128i*)values, hi);
+        _mm_store_si128((__m128i*)indices, hi_idx);
+        reduceLanes(values, indices, 4, false, &value, max_idx);
+
+        for (int j = i; j < length; j++) {
+            if (arr[j] > value) { value = arr[j]; *max_idx = j; }
+        }
+    }
+}
+
+#endif
+
+/**
+ * @brief Runs the min/max kernel for the CPU's instruction set.
+ */
+template <bool WANT_MIN, bool WANT_MAX>
+static void minMaxIdx(const int arr[], const int length, int* min_idx, int* max_idx) {
+#if SIMD_X86
+    switch (simdLevel()) {
+        case SIMD_AVX2:
+            minMaxIdxAvx2<WANT_MIN, WANT_MAX>(arr, length, min_idx, max_idx);
+            return;
+        case SIMD_SSE41:
+            minMaxIdxSse41<WANT_MIN, WANT_MAX>(arr, length, min_idx, max_idx);
+            return;
+        default:
+            break;
+    }
+#endif
+    minMaxIdxScalar<WANT_MIN, WANT_MAX>(arr, length, min_idx, max_idx);
+}
+
+/**
+ * @brief Returns the index of the first minimum element of a non-empty array.
+ *
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array; must be positive.
+ */
+int simdMinIdx(const int arr[], const int length) {
+    int min_idx;
+    minMaxIdx<true, false>(arr, length, &min_idx, nullptr);
+    return min_idx;
+}
+
+/**
+ * @brief Returns the index of the first maximum element of a non-empty array.
+ *
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array; must be positive.
+ */
+int simdMaxIdx(const int arr[], const int length) {
+    int max_idx;
+    minMaxIdx<false, true>(arr, length, nullptr, &max_idx);
+    return max_idx;
+}
+
+/**
+ * @brief Finds the first minimum & the first maximum of a non-empty array in one pass.
+ *
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array; must be positive.
+ * @param min_idx, max_idx Receive the indices of the first minimum & first maximum.
+ */
+void simdMinMaxIdx(const int arr[], const int length, int* min_idx, int* max_idx) {
+    minMaxIdx<true, true>(arr, length, min_idx, max_idx);
+}
+
+/**
+ * @brief Returns the index of the first element equal to @p value one element at a time, or -1.
+ */
+static int findFirstScalar(const int value, const int arr[], const int begin, const int length) {
+    for (int i = begin; i < length; i++) {
+        if (arr[i] == value) return i;
+    }
+
+    return -1;
+}
+
+/**
+ * @brief Writes the indices of matches in arr[begin..length) to @p indices one element at a time.
+ *
+ * @return Total number of matches, including the ones past @p capacity.
+ */
+static int findAllScalar(const int value, const int arr[], const int begin, const int length,
+                         int indices[], const int capacity, int count) {
+    for (int i = begin; i < length; i++) {
+        if (arr[i] == value) {
+            if (count < capacity) indices[count] = i;
+            count++;
+        }
+    }
+
+    return count;
+}
+
+#if SIMD_X86
+
+/**
+ * @brief Returns the index of the first element equal to @p value, or -1, comparing 32 elements per iteration with AVX2.
+ */
+__attribute__((target("avx2")))
+static int findFirstAvx2(const int value, const int arr[], const int length) {
+    const __m256i needle = _mm256_set1_epi32(value);
+    int i = 0;
+
+    for (; i + 32 <= length; i += 32) {
+        __m256i eq0 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(arr+i)), needle);
+        __m256i eq1 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(arr+i+8)), needle);
+        __m256i eq2 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(arr+i+16)), needle);
+        __m256i eq3 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(arr+i+24)), needle);
+
+        // One test for all four vectors keeps the common no-match path to a single branch.
+        __m256i any = _mm256_or_si256(_mm256_or_si256(eq0, eq1), _mm256_or_si256(eq2, eq3));
+        if (_mm256_testz_si256(any, any)) {
+            continue;
+        }
+
+        unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq0))
+                      | (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq1)) << 8
+                      | (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq2)) << 16
+                      | (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq3)) << 24;
+        return i + __builtin_ctz(mask);
+    }
+
+    for (; i + 8 <= length; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(arr+i)), needle);
+        unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq));
+
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    return findFirstScalar(value, arr, i, length);
+}
+
+/**
+ * @brief Returns the number of elements equal to @p value, comparing 8 elements per step with AVX2.
+ */
+__attribute__((target("avx2")))
+static int countEqualAvx2(const int value, const int arr[], const int length) {
+    const __m256i needle = _mm256_set1_epi32(value);
+    __m256i counts = _mm256_setzero_si256();
+    int i = 0;
+
+    // A match compares to -1 in its lane, so subtracting the mask adds one per match.
+    for (; i + 8 <= length; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(arr+i)), needle);
+        counts = _mm256_sub_epi32(counts, eq);
+    }
+
+    alignas(32) int lanes[8];
+    _mm256_store_si256((__m256i*)lanes, counts);
+
+    int count = 0;
+    for (int l = 0; l < 8; l++) {
+        count += lanes[l];
+    }
+    for (; i < length; i++) {
+        count += arr[i] == value;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Writes the indices of all elements equal to @p value to @p indices, comparing 8 elements per step with AVX2.
+ *
+ * @return Total number of matches, including the ones past @p capacity.
+ */
+__attribute__((target("avx2")))
+static int findAllAvx2(const int value, const int arr[], const int length, int indices[], const int capacity) {
+    const __m256i needle = _mm256_set1_epi32(value);
+    int count = 0;
+    int i = 0;
+
+    for (; i + 8 <= length; i += 8) {
+        __m256i eq = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(arr+i)), needle);
+        unsigned mask = (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(eq));
+
+        while (mask) {
+            if (count < capacity) indices[count] = i + __builtin_ctz(mask);
+            count++;
+            mask &= mask - 1;
+        }
+    }
+
+    return findAllScalar(value, arr, i, length, indices, capacity, count);
+}
+
+/**
+ * @brief Returns the index of the first element equal to @p value, or -1, comparing 4 elements per step with SSE4.1.
+ */
+__attribute__((target("sse4.1")))
+static int findFirstSse41(const int value, const int arr[], const int length) {
+    const __m128i needle = _mm_set1_epi32(value);
+    int i = 0;
+
+    for (; i + 4 <= length; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(arr+i)), needle);
+        unsigned mask = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(eq));
+
+        if (mask) {
+            return i + __builtin_ctz(mask);
+        }
+    }
+
+    return findFirstScalar(value, arr, i, length);
+}
+
+/**
+ * @brief Returns the number of elements equal to @p value, comparing 4 elements per step with SSE4.1.
+ */
+__attribute__((target("sse4.1")))
+static int countEqualSse41(const int value, const int arr[], const int length) {
+    const __m128i needle = _mm_set1_epi32(value);
+    __m128i counts = _mm_setzero_si128();
+    int i = 0;
+
+    for (; i + 4 <= length; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(arr+i)), needle);
+        counts = _mm_sub_epi32(counts, eq);
+    }
+
+    int count = _mm_extract_epi32(counts, 0) + _mm_extract_epi32(counts, 1)
+              + _mm_extract_epi32(counts, 2) + _mm_extract_epi32(counts, 3);
+    for (; i < length; i++) {
+        count += arr[i] == value;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Writes the indices of all elements equal to @p value to @p indices, comparing 4 elements per step with SSE4.1.
+ *
+ * @return Total number of matches, including the ones past @p capacity.
+ */
+__attribute__((target("sse4.1")))
+static int findAllSse41(const int value, const int arr[], const int length, int indices[], const int capacity) {
+    const __m128i needle = _mm_set1_epi32(value);
+    int count = 0;
+    int i = 0;
+
+    for (; i + 4 <= length; i += 4) {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(arr+i)), needle);
+        unsigned mask = (unsigned)_mm_movemask_ps(_mm_castsi128_ps(eq));
+
+        while (mask) {
+            if (count < capacity) indices[count] = i + __builtin_ctz(mask);
+            count++;
+            mask &= mask - 1;
+        }
+    }
+
+    return findAllScalar(value, arr, i, length, indices, capacity, count);
+}
+
+/**
+ * @brief Returns the number of elements less than (or, if OR_EQUAL, not greater than) @p value, 8 per step with AVX2.
+ *
+ * Counts the elements greater than the bound & subtracts: x < value is value > x, & x <= value is !(x > value).
+ */
+template <bool OR_EQUAL>
+__attribute__((target("avx2")))
+static int countLessAvx2(const int value, const int arr[], const int length) {
+    const __m256i bound = _mm256_set1_epi32(value);
+    int count = 0;
+    int i = 0;
+
+    for (; i + 8 <= length; i += 8) {
+        __m256i x = _mm256_loadu_si256((const __m256i*)(arr+i));
+        __m256i hit = OR_EQUAL ? _mm256_cmpgt_epi32(x, bound) : _mm256_cmpgt_epi32(bound, x);
+        int bits = __builtin_popcount((unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(hit)));
+
+        count += OR_EQUAL ? 8 - bits : bits;
+    }
+    for (; i < length; i++) {
+        count += OR_EQUAL ? arr[i] <= value : arr[i] < value;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Returns the number of elements less than (or, if OR_EQUAL, not greater than) @p value, 4 per step with SSE4.1.
+ */
+template <bool OR_EQUAL>
+__attribute__((target("sse4.1")))
+static int countLessSse41(const int value, const int arr[], const int length) {
+    const __m128i bound = _mm_set1_epi32(value);
+    int count = 0;
+    int i = 0;
+
+    for (; i + 4 <= length; i += 4) {
+        __m128i x = _mm_loadu_si128((const __m128i*)(arr+i));
+        __m128i hit = OR_EQUAL ? _mm_cmpgt_epi32(x, bound) : _mm_cmpgt_epi32(bound, x);
+        int bits = __builtin_popcount((unsigned)_mm_movemask_ps(_mm_castsi128_ps(hit)));
+
+        count += OR_EQUAL ? 4 - bits : bits;
+    }
+    for (; i < length; i++) {
+        count += OR_EQUAL ? arr[i] <= value : arr[i] < value;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Returns the number of keys of a 64-byte aligned tree node less than @p bound with two AVX2 compares.
+ *
+ * Packing the two 8-lane masks to 16-bit lanes gives one byte mask with two bits per key.
+ */
+__attribute__((target("avx2")))
+static inline int nodeRankAvx2(const __m256i bound, const int node[]) {
+    __m256i lo = _mm256_load_si256((const __m256i*)node);
+    __m256i hi = _mm256_load_si256((const __m256i*)(node+8));
+    __m256i less = _mm256_packs_epi32(_mm256_cmpgt_epi32(bound, lo), _mm256_cmpgt_epi32(bound, hi));
+
+    return __builtin_popcount((unsigned)_mm256_movemask_epi8(less)) / 2;
+}
+
+/**
+ * @brief Returns the number of keys of a 64-byte aligned tree node less than @p bound with four SSE4.1 compares.
+ */
+__attribute__((target("sse4.1")))
+static inline int nodeRankSse41(const __m128i bound, const int node[]) {
+    __m128i a = _mm_cmpgt_epi32(bound, _mm_load_si128((const __m128i*)node));
+    __m128i b = _mm_cmpgt_epi32(bound, _mm_load_si128((const __m128i*)(node+4)));
+    __m128i c = _mm_cmpgt_epi32(bound, _mm_load_si128((const __m128i*)(node+8)));
+    __m128i d = _mm_cmpgt_epi32(bound, _mm_load_si128((const __m128i*)(node+12)));
+    __m128i less = _mm_packs_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+
+    return __builtin_popcount((unsigned)_mm_movemask_epi8(less));
+}
+
+/**
+ * @brief Walks a static search tree from the root to a leaf with one AVX2 node rank per layer.
+ */
+__attribute__((target("avx2")))
+static size_t treeLowerBoundAvx2(const int value, const int* const layers[], const int height) {
+    const __m256i bound = _mm256_set1_epi32(value);
+    size_t k = 0;
+
+    for (int h = height - 1; h > 0; h--) {
+        k = k*(SIMD_TREE_NODE_KEYS+1) + nodeRankAvx2(bound, layers[h] + k*SIMD_TREE_NODE_KEYS);
+    }
+
+    return k*SIMD_TREE_NODE_KEYS + nodeRankAvx2(bound, layers[0] + k*SIMD_TREE_NODE_KEYS);
+}
+
+/**
+ * @brief Walks a static search tree from the root to a leaf with one SSE4.1 node rank per layer.
+ */
+__attribute__((target("sse4.1")))
+static size_t treeLowerBoundSse41(const int value, const int* const layers[], const int height) {
+    const __m128i bound = _mm_set1_epi32(value);
+    size_t k = 0;
+
+    for (int h = height - 1; h > 0; h--) {
+        k = k*(SIMD_TREE_NODE_KEYS+1) + nodeRankSse41(bound, layers[h] + k*SIMD_TREE_NODE_KEYS);
+    }
+
+    return k*SIMD_TREE_NODE_KEYS + nodeRankSse41(bound, layers[0] + k*SIMD_TREE_NODE_KEYS);
+}
+
+#endif
+
+/**
+ * @brief Returns the index of the first element of arr[0..length) equal to @p value, or -1.
+ *
+ * @param value Number to search for.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ */
+int simdFindFirst(const int value, const int arr[], const int length) {
+#if SIMD_X86
+    switch (simdLevel()) {
+        case SIMD_AVX2:
+            return findFirstAvx2(value, arr, length);
+        case SIMD_SSE41:
+            return findFirstSse41(value, arr, length);
+        default:
+            break;
+    }
+#endif
+    return findFirstScalar(value, arr, 0, length);
+}
+
+/**
+ * @brief Returns the number of elements of arr[0..length) equal to @p value.
+ *
+ * @param value Number to count.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ */
+int simdCountEqual(const int value, const int arr[], const int length) {
+#if SIMD_X86
+    switch (simdLevel()) {
+        case SIMD_AVX2:
+            return countEqualAvx2(value, arr, length);
+        case SIMD_SSE41:
+            return countEqualSse41(value, arr, length);
+        default:
+            break;
+    }
+#endif
+    int count = 0;
+    for (int i = 0; i < length; i++) {
+        count += arr[i] == value;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Writes the indices of the elements of arr[0..length) equal to @p value, in increasing order.
+ *
+ * @param value Number to search for.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param indices Buffer that receives up to @p capacity indices.
+ * @param capacity Number of indices @p indices can hold.
+ *
+ * @return Total number of matches, including the ones past @p capacity.
+ */
+int simdFindAll(const int value, const int arr[], const int length, int indices[], const int capacity) {
+#if SIMD_X86
+    switch (simdLevel()) {
+        case SIMD_AVX2:
+            return findAllAvx2(value, arr, length, indices, capacity);
+        case SIMD_SSE41:
+            return findAllSse41(value, arr, length, indices, capacity);
+        default:
+            break;
+    }
+#endif
+    return findAllScalar(value, arr, 0, length, indices, capacity, 0);
+}
+
+/**
+ * @brief Returns the number of elements of arr[0..length) less than @p value.
+ *
+ * On a sorted array, this is the index of the first element not less than @p value,
+ * found without a single data-dependent branch.
+ *
+ * @param value Bound to compare with.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ */
+int simdCountLess(const int value, const int arr[], const int length) {
+#if SIMD_X86
+    switch (simdLevel()) {
+        case SIMD_AVX2:
+            return countLessAvx2<false>(value, arr, length);
+        case SIMD_SSE41:
+            return countLessSse41<false>(value, arr, length);
+        default:
+            break;
+    }
+#endif
+    int count = 0;
+    for (int i = 0; i < length; i++) {
+        count += arr[i] < value;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Returns the number of elements of arr[0..length) less than or equal to @p value.
+ *
+ * On a sorted array, this is the index of the first element greater than @p value.
+ *
+ * @param value Bound to compare with.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ */
+int simdCountLessEqual(const int value, const int arr[], const int length) {
+#if SIMD_X86
+    switch (simdLevel()) {
+        case SIMD_AVX2:
+            return countLessAvx2<true>(value, arr, length);
+        case SIMD_SSE41:
+            return countLessSse41<true>(value, arr, length);
+        default:
+            break;
+    }
+#endif
+    int count = 0;
+    for (int i = 0; i < length; i++) {
+        count += arr[i] <= value;
+    }
+
+    return count;
+}
+
+/**
+ * @brief Returns the lower bound of @p value in the leaf layer of a static search tree.
+ *
+ * The tree is stored as in StaticTreeIndex (search.h): every node is SIMD_TREE_NODE_KEYS
+ * keys on one 64-byte aligned line; node k of layer h has children k*(B+1) .. k*(B+1)+B
+ * in layer h-1, & its key i is the smallest key under child i+1. Counting a node's keys
+ * below @p value therefore picks the child to descend into, & in a leaf, the offset of
+ * the bound.
+ *
+ * @param value Number to search for.
+ * @param layers Pointers to the layers, leaves first; layers[height-1] is the root node.
+ * @param height Number of layers, at least 1.
+ *
+ * @return Index in layers[0] of the first key not less than @p value; its padded length, if there is none.
+ */
+size_t simdTreeLowerBound(const int value, const int* const layers[], const int height) {
+#if SIMD_X86
+    switch (simdLevel()) {
+        case SIMD_AVX2:
+            return treeLowerBoundAvx2(value, layers, height);
+        case SIMD_SSE41:
+            return treeLowerBoundSse41(value, layers, height);
+        default:
+            break;
+    }
+#endif
+    size_t k = 0;
+
+    for (int h = height - 1; h >= 0; h--) {
+        const int* node = layers[h] + k*SIMD_TREE_NODE_KEYS;
+        int rank = 0;
+        for (int i = 0; i < SIMD_TREE_NODE_KEYS; i++) {
+            rank += node[i] < value;
+        }
+        k = h > 0 ? k*(SIMD_TREE_NODE_KEYS+1) + rank : k*SIMD_TREE_NODE_KEYS + rank;
+    }
+
+    return k;
+}
@@ -0,0 +1,40 @@
+/**
+ * @file simd.h
+ * @brief SIMD kernels with runtime CPU dispatch - Min/Max index reductions, Equality scans, Rank scans, Search tree descent.
+ *
+ * Each kernel has AVX2, SSE4.1 & scalar versions. The best version the CPU supports
+ * is picked on the first call. The kernels skip argument validation; the public
+ * wrappers in sort.cpp & linear_search.cpp do that.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#pragma once
+
+#include <cstddef>
+
+// The kernels index with int; longer arrays are processed in blocks of at most this many elements.
+static const size_t SIMD_MAX_BLOCK = (size_t)1 << 30;
+// Keys per search tree node: one 64-byte cache line, two AVX2 or four SSE compares.
+static const int SIMD_TREE_NODE_KEYS = 16;
+
+// ====== Dispatch ======
+const char* simdLevelName();
+
+// ====== Reductions ======
+int simdMinIdx(const int[], const int);
+int simdMaxIdx(const int[], const int);
+void simdMinMaxIdx(const int[], const int, int*, int*);
+
+// ====== Equality Scans ======
+int simdFindFirst(const int, const int[], const int);
+int simdCountEqual(const int, const int[], const int);
+int simdFindAll(const int, const int[], const int, int[], const int);
+
+// ====== Rank Scans ======
+int simdCountLess(const int, const int[], const int);
+int simdCountLessEqual(const int, const int[], const int);
+
+// ====== Search Tree Descent ======
+size_t simdTreeLowerBound(const int, const int* const[], const int);
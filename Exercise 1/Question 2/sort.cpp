@@ -1,26 +1,55 @@
 
 /**
  * @file sort.cpp
- * @brief Sorting algorithms - Bubble Sort, Insertion Sort, Selection Sort.
+ * @brief Sorting algorithms - Bubble Sort, Insertion Sort, Selection Sort, Heap Sort, Intro Sort, Adaptive Sort.
  * 
- * Provides function definitions for sorting algorithms.
+ * Provides function definitions for sorting algorithms. The int-only functions are thin
+ * wrappers that pick the comparator once & call the templates in sort_templates.h.
  * 
  * @author Abdullah Sheriff
  * @date Februrary 8th, 2025
  */
 
+#include <algorithm>
 #include <iostream>
+#include <functional>
+#include <utility>
+#include <vector>
+#include "scratch_arena.h"
 #include "sort.h"
+#include "sort_stats.h"
+#include "simd.h"
+#include "span_api.h"
 
 // ====== Utilities ======
 void swapIntegers(int*, int*);
 int findMinIdx(const int[], const int);
 int findMaxIdx(const int[], const int);
+int findMinMaxIdx(const int[], const int, int*, int*);
 
 // ====== Sorting Functions ======
 void bubbleSort(int[], const int, bool desc);
 void insertionSort(int[], const int, bool desc);
 void selectionSort(int[], const int, bool desc);
+void heapSort(int[], const int, bool desc);
+void introSort(int[], const int, bool desc);
+void adaptiveSort(int[], const int, bool desc);
+
+namespace dsa {
+// ====== 64-bit Utilities ======
+std::optional<size_t> findMinIdx(std::span<const int>);
+std::optional<size_t> findMaxIdx(std::span<const int>);
+std::optional<std::pair<size_t, size_t>> findMinMaxIdx(std::span<const int>);
+
+// ====== 64-bit Sorting Functions ======
+void bubbleSort(std::span<int>, bool desc);
+void insertionSort(std::span<int>, bool desc);
+void selectionSort(std::span<int>, bool desc);
+void heapSort(std::span<int>, bool desc);
+void introSort(std::span<int>, bool desc);
+void adaptiveSort(std::span<int>, bool desc);
+void stableSort(std::span<int>, bool desc);
+}
 
 
 /**
@@ -69,19 +98,8 @@ int findMinIdx(const int arr[], const int length) {
     if (length <= 0) {
         return -2;
     }
-    if (length == 1) {
-        return 0;
-    }
-    
-    int min_idx = 0;
 
-    for (int i = 0; i < length; i++) {
-        if (arr[i] < arr[min_idx]) {
-            min_idx = i;
-        }
-    }
-
-    return min_idx;
+    return simdMinIdx(arr, length);
 }
 
 /**
@@ -105,19 +123,39 @@ int findMaxIdx(const int arr[], const int length) {
     if (length <= 0) {
         return -2;
     }
-    if (length == 1) {
-        return 0;
-    }
-    
-    int max_idx = 0;
 
-    for (int i = 0; i < length; i++) {
-        if (arr[i] > arr[max_idx]) {
-            max_idx = i;
-        }
+    return simdMaxIdx(arr, length);
+}
+
+/**
+ * @brief Finds the indices of the minimum & the maximum elements in one pass over the array.
+ * 
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param min_idx Pointer that receives the index of the minimum element.
+ * @param max_idx Pointer that receives the index of the maximum element.
+ * 
+ * @return 0, if both indices were found.
+ * @return -2, if @p arr, @p min_idx or @p max_idx is null or if @p length is a non-positive integer.
+ * 
+ * @note Ties resolve to the first occurrence, like findMinIdx & findMaxIdx.
+ * 
+ * @code
+ * int arr[] = {5, 1, 2, 3, 4};
+ * int min_idx, max_idx;
+ * findMinMaxIdx(arr, 5, &min_idx, &max_idx); // min_idx is 1 & max_idx is 0
+ * @endcode
+ */
+int findMinMaxIdx(const int arr[], const int length, int* min_idx, int* max_idx) {
+    if (!arr || !min_idx || !max_idx) {
+        return -2;
+    }
+    if (length <= 0) {
+        return -2;
     }
 
-    return max_idx;
+    simdMinMaxIdx(arr, length, min_idx, max_idx);
+    return 0;
 }
 
 /**
@@ -150,13 +188,7 @@ void bubbleSort(int arr[], const int length, const bool desc) {
         return;
     }
 
-    for (int i = 0; i < length-1; i++) {
-        for (int j = 0; j < length-i-1; j++) {
-            if (desc ? arr[j] < arr[j+1] : arr[j] > arr[j+1]) {
-                swapIntegers(&arr[j], &arr[j+1]);
-            }
-        }
-    }
+    dsa::bubbleSort(std::span<int>(arr, length), desc);
 }
 
 /**
@@ -167,6 +199,7 @@ void bubbleSort(int arr[], const int length, const bool desc) {
  * @param desc If true, sorts the array in descending order; otherwise, sorts it in ascending order. (default=false)
  * 
  * @note @p arr must be a non-null pointer, and @p length must be a non-negative integer.
+ * @note To get only the k smallest elements, partialSort & topK do it in O(n + k log k) & O(n log k).
  * 
  * @code
  * int arr[] = {5, 1, 2, 3, 4};
@@ -189,17 +222,7 @@ void selectionSort(int arr[], const int length, const bool desc) {
         return;
     }
 
-    int swapIdx;
-
-    for (int i = 0; i < length-1; i++) {
-        if (desc) {
-            swapIdx = findMaxIdx(arr+i, length-i) + i;
-        } else {
-            swapIdx = findMinIdx(arr+i, length-i) + i;
-        }
-
-        swapIntegers(&arr[swapIdx], &arr[i]);
-    }
+    dsa::selectionSort(std::span<int>(arr, length), desc);
 }
 
 /**
@@ -232,14 +255,403 @@ void insertionSort(int arr[], const int length, const bool desc) {
         return;
     }
 
-    for (int i = 1; i < length; i++) {
-        for (int j = i; j > 0; j--) {
-            if (desc ? arr[j] < arr[j-1] : arr[j] > arr[j-1]) {
-                break;
-            }
-            else {
-                swapIntegers(&arr[j], &arr[j-1]);
-            }
+    dsa::insertionSort(std::span<int>(arr, length), desc);
+}
+
+/**
+ * @brief Sorts the array in ascending order using Heap sort algorithm.
+ * 
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param desc If true, sorts the array in descending order; otherwise, sorts it in ascending order. (default=false)
+ * 
+ * @note @p arr must be a non-null pointer, and @p length must be a non-negative integer.
+ * 
+ * @code
+ * int arr[] = {5, 1, 2, 3, 4};
+ * 
+ * heapSort(arr, 5);
+ * // Sorted array: 1 2 3 4 5
+ * 
+ * heapSort(arr, 5, true);
+ * // Sorted array: 5 4 3 2 1
+ * @endcode
+ */
+void heapSort(int arr[], const int length, const bool desc) {
+    /*
+    In-place Heap sort.
+    */
+    if (!arr) {
+        return;
+    }
+    if (length <= 0) {
+        return;
+    }
+
+    dsa::heapSort(std::span<int>(arr, length), desc);
+}
+
+/**
+ * @brief Sorts the array in ascending order using Intro sort algorithm.
+ * 
+ * Median-of-three quicksort that falls back to heap sort when the recursion gets
+ * deeper than 2*log2(length), and hands small partitions to insertion sort.
+ * Runs in O(n log n) in the worst case.
+ * 
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param desc If true, sorts the array in descending order; otherwise, sorts it in ascending order. (default=false)
+ * 
+ * @note @p arr must be a non-null pointer, and @p length must be a non-negative integer.
+ * 
+ * @code
+ * int arr[] = {5, 1, 2, 3, 4};
+ * 
+ * introSort(arr, 5);
+ * // Sorted array: 1 2 3 4 5
+ * 
+ * introSort(arr, 5, true);
+ * // Sorted array: 5 4 3 2 1
+ * @endcode
+ */
+void introSort(int arr[], const int length, const bool desc) {
+    /*
+    In-place Intro sort.
+    */
+    if (!arr) {
+        return;
+    }
+    if (length <= 0) {
+        return;
+    }
+
+    dsa::introSort(std::span<int>(arr, length), desc);
+}
+
+/**
+ * @brief Sorts the array in ascending order using an adaptive merge sort over its natural runs.
+ * 
+ * Detects ascending & descending runs and merges them with galloping, so sorted, reversed
+ * & concatenated sorted input take linear or near-linear time. Random input, whose runs
+ * are short, is sorted with pattern-defeating quicksort instead.
+ * 
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param desc If true, sorts the array in descending order; otherwise, sorts it in ascending order. (default=false)
+ * 
+ * @note @p arr must be a non-null pointer, and @p length must be a non-negative integer.
+ * @note Merging needs a scratch buffer of @p length/2 integers; if it cannot be allocated, falls back to pdqSort.
+ * 
+ * @code
+ * int arr[] = {1, 3, 5, 2, 4, 6};
+ * 
+ * adaptiveSort(arr, 6);
+ * // Sorted array: 1 2 3 4 5 6
+ * 
+ * adaptiveSort(arr, 6, true);
+ * // Sorted array: 6 5 4 3 2 1
+ * @endcode
+ */
+void adaptiveSort(int arr[], const int length, const bool desc) {
+    if (!arr) {
+        return;
+    }
+    if (length <= 0) {
+        return;
+    }
+
+    dsa::adaptiveSort(std::span<int>(arr, length), desc);
+}
+
+/**
+ * @brief Returns the index of the minimum element in the array.
+ * 
+ * Runs the SIMD kernel on blocks of SIMD_MAX_BLOCK elements, so any length is supported.
+ * 
+ * @param arr Array to search.
+ * 
+ * @return Index of the first minimum element; std::nullopt, if @p arr is empty.
+ * 
+ * @code
+ * std::vector<int> arr = {5, 1, 2, 1, 4};
+ * dsa::findMinIdx(arr); // Returns 1
+ * @endcode
+ */
+std::optional<size_t> dsa::findMinIdx(std::span<const int> arr) {
+    if (arr.empty()) {
+        return std::nullopt;
+    }
+
+    size_t min_idx = 0;
+
+    for (size_t begin = 0; begin < arr.size(); begin += SIMD_MAX_BLOCK) {
+        size_t idx = begin + simdMinIdx(arr.data() + begin, (int)std::min(SIMD_MAX_BLOCK, arr.size() - begin));
+        // Strict comparison keeps the first occurrence across blocks.
+        if (arr[idx] < arr[min_idx]) {
+            min_idx = idx;
+        }
+    }
+
+    return min_idx;
+}
+
+/**
+ * @brief Returns the index of the maximum element in the array.
+ * 
+ * @param arr Array to search.
+ * 
+ * @return Index of the first maximum element; std::nullopt, if @p arr is empty.
+ * 
+ * @code
+ * std::vector<int> arr = {5, 1, 2, 5, 4};
+ * dsa::findMaxIdx(arr); // Returns 0
+ * @endcode
+ */
+std::optional<size_t> dsa::findMaxIdx(std::span<const int> arr) {
+    if (arr.empty()) {
+        return std::nullopt;
+    }
+
+    size_t max_idx = 0;
+
+    for (size_t begin = 0; begin < arr.size(); begin += SIMD_MAX_BLOCK) {
+        size_t idx = begin + simdMaxIdx(arr.data() + begin, (int)std::min(SIMD_MAX_BLOCK, arr.size() - begin));
+        if (arr[idx] > arr[max_idx]) {
+            max_idx = idx;
+        }
+    }
+
+    return max_idx;
+}
+
+/**
+ * @brief Finds the indices of the minimum & the maximum elements in one pass over the array.
+ * 
+ * @param arr Array to search.
+ * 
+ * @return Pair of the first minimum's & the first maximum's indices; std::nullopt, if @p arr is empty.
+ * 
+ * @code
+ * std::vector<int> arr = {5, 1, 2, 3, 4};
+ * auto [min_idx, max_idx] = *dsa::findMinMaxIdx(arr); // min_idx is 1 & max_idx is 0
+ * @endcode
+ */
+std::optional<std::pair<size_t, size_t>> dsa::findMinMaxIdx(std::span<const int> arr) {
+    if (arr.empty()) {
+        return std::nullopt;
+    }
+
+    size_t min_idx = 0, max_idx = 0;
+
+    for (size_t begin = 0; begin < arr.size(); begin += SIMD_MAX_BLOCK) {
+        int block_min, block_max;
+        simdMinMaxIdx(arr.data() + begin, (int)std::min(SIMD_MAX_BLOCK, arr.size() - begin), &block_min, &block_max);
+
+        if (arr[begin + block_min] < arr[min_idx]) {
+            min_idx = begin + block_min;
+        }
+        if (arr[begin + block_max] > arr[max_idx]) {
+            max_idx = begin + block_max;
         }
     }
-}
\ No newline at end of file
+
+    return std::make_pair(min_idx, max_idx);
+}
+
+/**
+ * @brief In builds with DSA_INSTRUMENT, sorts the array by running @p sort on CountedInt copies of its elements,
+ * so that the thread's comparison, swap & move counts include the sort's. Otherwise does nothing.
+ * 
+ * @param sort Calls a sort template with (first, last, comp).
+ * 
+ * @return True, if the array was sorted; the caller then skips its uncounted sort.
+ */
+template <typename Sort>
+static bool sortCounted([[maybe_unused]] std::span<int> arr, [[maybe_unused]] const bool desc, [[maybe_unused]] Sort sort) {
+#ifdef DSA_INSTRUMENT
+    // Built from & read back as plain ints, so the copies add no moves.
+    std::vector<CountedInt> counted(arr.begin(), arr.end());
+
+    if (desc) {
+        sort(counted.begin(), counted.end(), std::greater<>());
+    } else {
+        sort(counted.begin(), counted.end(), std::less<>());
+    }
+
+    for (size_t i = 0; i < arr.size(); i++) {
+        arr[i] = counted[i].value;
+    }
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * @brief Sorts the array in ascending order using Bubble sort algorithm.
+ * 
+ * @param arr Array to sort.
+ * @param desc If true, sorts the array in descending order; otherwise, sorts it in ascending order. (default=false)
+ */
+void dsa::bubbleSort(std::span<int> arr, const bool desc) {
+    if (sortCounted(arr, desc, [](auto first, auto last, auto comp) { ::bubbleSort(first, last, comp); })) {
+        return;
+    }
+
+    if (desc) {
+        ::bubbleSort(arr.begin(), arr.end(), std::greater<int>());
+    } else {
+        ::bubbleSort(arr.begin(), arr.end(), std::less<int>());
+    }
+}
+
+/**
+ * @brief Sorts the array in ascending order using Insertion sort algorithm.
+ * 
+ * @param arr Array to sort.
+ * @param desc If true, sorts the array in descending order; otherwise, sorts it in ascending order. (default=false)
+ */
+void dsa::insertionSort(std::span<int> arr, const bool desc) {
+    if (sortCounted(arr, desc, [](auto first, auto last, auto comp) { ::insertionSort(first, last, comp); })) {
+        return;
+    }
+
+    if (desc) {
+        ::insertionSort(arr.begin(), arr.end(), std::greater<int>());
+    } else {
+        ::insertionSort(arr.begin(), arr.end(), std::less<int>());
+    }
+}
+
+/**
+ * @brief Sorts the array in ascending order using Selection sort algorithm.
+ * 
+ * Finds each minimum (maximum, if @p desc) with the vectorized index kernels; the
+ * generic template scans one element at a time.
+ * 
+ * @param arr Array to sort.
+ * @param desc If true, sorts the array in descending order; otherwise, sorts it in ascending order. (default=false)
+ */
+void dsa::selectionSort(std::span<int> arr, const bool desc) {
+    for (size_t i = 0; i + 1 < arr.size(); i++) {
+        size_t swap_idx = i + *(desc ? findMaxIdx(arr.subspan(i)) : findMinIdx(arr.subspan(i)));
+        std::swap(arr[swap_idx], arr[i]);
+
+        // The kernels compare every remaining element with the running minimum (maximum).
+        countComparisons(arr.size() - i - 1);
+        countSwaps(1);
+    }
+}
+
+/**
+ * @brief Sorts the array in ascending order using Heap sort algorithm.
+ * 
+ * @param arr Array to sort.
+ * @param desc If true, sorts the array in descending order; otherwise, sorts it in ascending order. (default=false)
+ */
+void dsa::heapSort(std::span<int> arr, const bool desc) {
+    if (sortCounted(arr, desc, [](auto first, auto last, auto comp) { ::heapSort(first, last, comp); })) {
+        return;
+    }
+
+    if (desc) {
+        ::heapSort(arr.begin(), arr.end(), std::greater<int>());
+    } else {
+        ::heapSort(arr.begin(), arr.end(), std::less<int>());
+    }
+}
+
+/**
+ * @brief Sorts the array in ascending order using Intro sort algorithm.
+ * 
+ * @param arr Array to sort.
+ * @param desc If true, sorts the array in descending order; otherwise, sorts it in ascending order. (default=false)
+ * 
+ * @code
+ * std::vector<int> arr = {5, 1, 2, 3, 4};
+ * 
+ * dsa::introSort(arr);
+ * // Sorted array: 1 2 3 4 5
+ * 
+ * dsa::introSort(std::span(arr).first(3), true);
+ * // Sorted array: 3 2 1 4 5
+ * @endcode
+ */
+void dsa::introSort(std::span<int> arr, const bool desc) {
+    if (sortCounted(arr, desc, [](auto first, auto last, auto comp) { ::introSort(first, last, comp); })) {
+        return;
+    }
+
+    if (desc) {
+        ::introSort(arr.begin(), arr.end(), std::greater<int>());
+    } else {
+        ::introSort(arr.begin(), arr.end(), std::less<int>());
+    }
+}
+
+/**
+ * @brief Same as the adaptiveSort template, with the run boundaries & merge buffer taken from the thread's scratch arena.
+ */
+template <typename Compare>
+static void adaptiveSortScratch(std::span<int> arr, Compare comp) {
+    const size_t length = arr.size();
+    if (length < (size_t)ADAPTIVE_MIN_RUN) {
+        insertionSort(arr.begin(), arr.end(), comp);
+        return;
+    }
+
+    size_t max_runs = length / ADAPTIVE_MIN_AVERAGE_RUN;
+    size_t num_runs = countRuns(arr.begin(), arr.end(), comp, max_runs);
+
+    if (num_runs > max_runs) {
+        pdqSort(arr.begin(), arr.end(), comp);
+        return;
+    }
+
+    ScratchArena& arena = threadScratchArena();
+    ScratchScope scope(arena);
+    ptrdiff_t* bounds = arena.allocateArray<ptrdiff_t>(num_runs + 1);
+    int* buffer = num_runs > 1 ? arena.allocateArray<int>(length/2 + 1) : nullptr;
+
+    if (!bounds || (num_runs > 1 && !buffer)) {
+        pdqSort(arr.begin(), arr.end(), comp);
+        return;
+    }
+
+    mergeNaturalRuns(arr.begin(), arr.end(), comp, bounds, buffer);
+}
+
+/**
+ * @brief Sorts the array in ascending order using an adaptive merge sort over its natural runs.
+ * 
+ * @param arr Array to sort.
+ * @param desc If true, sorts the array in descending order; otherwise, sorts it in ascending order. (default=false)
+ * 
+ * @note The merge buffer comes from threadScratchArena(); if it cannot be mapped, falls back to pdqSort.
+ */
+void dsa::adaptiveSort(std::span<int> arr, const bool desc) {
+    /*
+    In-place Adaptive merge sort.
+    */
+    if (sortCounted(arr, desc, [](auto first, auto last, auto comp) { ::adaptiveSort(first, last, comp); })) {
+        return;
+    }
+
+    if (desc) {
+        adaptiveSortScratch(arr, std::greater<int>());
+    } else {
+        adaptiveSortScratch(arr, std::less<int>());
+    }
+}
+
+/**
+ * @brief Sorts the array in ascending order using a stable sort.
+ * 
+ * @param arr Array to sort.
+ * @param desc If true, sorts the array in descending order; otherwise, sorts it in ascending order. (default=false)
+ * 
+ * @note Equal ints cannot be told apart, so this is dsa::radixSort, which is stable (LSD).
+ */
+void dsa::stableSort(std::span<int> arr, const bool desc) {
+    dsa::radixSort(arr, desc);
+}
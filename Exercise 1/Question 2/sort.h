@@ -1,9 +1,10 @@
 
 /**
  * @file sort.h
- * @brief Sorting algorithms - Bubble Sort, Insertion Sort, Selection Sort.
+ * @brief Sorting algorithms - Bubble Sort, Insertion Sort, Selection Sort, Heap Sort, Intro Sort, Adaptive Sort, Radix Sort, Stable Sort, Argsort, Parallel Merge Sort, External Merge Sort.
  * 
- * Provides function declarations for sorting algorithms.
+ * Provides function declarations for sorting algorithms on int arrays. Generic versions
+ * over any iterator & comparator live in sort_templates.h.
  * 
  * @author Abdullah Sheriff
  * @date Februrary 8th, 2025
@@ -11,12 +12,36 @@
 
 #pragma once
 
+#include <cstddef>
+#include "sort_templates.h"
+
 // ====== Utilities ======
 void swapIntegers(int*, int*);
 int findMinIdx(const int[], const int);
 int findMaxIdx(const int[], const int);
+int findMinMaxIdx(const int[], const int, int*, int*);
 
 // ====== Sorting Functions ======
 void bubbleSort(int[], const int, bool desc=false);
 void insertionSort(int[], const int, bool desc=false);
-void selectionSort(int[], const int, bool desc=false);
\ No newline at end of file
+void selectionSort(int[], const int, bool desc=false);
+void heapSort(int[], const int, bool desc=false);
+void introSort(int[], const int, bool desc=false);
+void adaptiveSort(int[], const int, bool desc=false);
+void radixSort(int[], const int, bool desc=false, int num_threads=0);
+
+// ====== Stable Sorting Functions ======
+void stableSort(int[], const int, bool desc=false);
+int argSort(const int[], const int, int[], bool desc=false);
+int sortByKey(int[], int[], const int, bool desc=false);
+
+// ====== Selection Functions ======
+int partialSort(int[], const int, const int, bool desc=false);
+int nthElement(int[], const int, const int, bool desc=false);
+int topK(const int[], const int, const int, int[], bool desc=false);
+
+// ====== Parallel Sorting Functions ======
+void parallelMergeSort(int[], const int, bool desc=false, int num_threads=0);
+
+// ====== External Sorting Functions ======
+int externalSort(const char*, const char*, const size_t, void (*sort)(int[], const int, bool)=nullptr, bool desc=false, const char* temp_dir=nullptr);
@@ -0,0 +1,247 @@
+/**
+ * @file sort_main.cpp
+ * @brief Program to sort a user-defined array, interactively or from a file.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "array_file.h"
+#include "io.h"
+#include "sort.h"
+#include "sort_stats.h"
+
+using std::cin;
+using std::cout;
+using std::cerr;
+using std::endl;
+
+/**
+ * @brief Sorting algorithm selectable from the menu & the command line.
+ */
+struct SortAlgorithm {
+    const char* menu_name;
+    const char* cli_name;
+    void (*sort)(int[], const int, bool);
+};
+
+// ====== Batch Mode ======
+int runBatchSort(int, char*[]);
+static size_t parseByteSize(const char*);
+
+// Worker threads for the radix & parallel sorts, set by --threads. 0 uses every hardware thread.
+static int batch_threads = 0;
+
+static const SortAlgorithm SORT_ALGORITHMS[] = {
+    {"Bubble Sort", "bubble", bubbleSort},
+    {"Selection Sort", "selection", selectionSort},
+    {"Insertion Sort", "insertion", insertionSort},
+    {"Heap Sort", "heap", heapSort},
+    {"Intro Sort", "intro", introSort},
+    {"Adaptive Sort", "adaptive", adaptiveSort},
+    {"Stable Sort", "stable", stableSort},
+    {"Radix Sort", "radix", [](int arr[], const int length, bool desc) { radixSort(arr, length, desc, batch_threads); }},
+    {"Parallel Merge Sort", "parallel", [](int arr[], const int length, bool desc) { parallelMergeSort(arr, length, desc, batch_threads); }},
+};
+static const unsigned int NUM_SORT_ALGORITHMS = sizeof(SORT_ALGORITHMS) / sizeof(SORT_ALGORITHMS[0]);
+
+static const char* const BATCH_OPTIONS[] = {"algo", "input", "output", "desc", "threads", "binary", "in-place",
+                                             "memory", "temp-dir", "stats", nullptr};
+
+
+/*
+Usage:
+    sort                                    Interactive menu.
+    sort --algo=NAME --input=FILE [--output=FILE] [--binary] [--desc] [--threads=N] [--stats]
+    sort --algo=NAME --input=FILE --in-place [--desc] [--threads=N] [--stats]
+    sort --algo=NAME --input=FILE --output=FILE --memory=SIZE [--temp-dir=DIR] [--desc] [--threads=N]
+         NAME: bubble, selection, insertion, heap, intro, adaptive, stable, radix, parallel
+         FILE: whitespace-separated integers, or an array file (see array_file.h)
+*/
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        return runBatchSort(argc, argv);
+    }
+
+    int length;
+    unsigned int user_choice;
+    int* arr; int* arr_copy;
+
+    length = getArrayLengthInput();
+    arr = getArrayInput(length);
+    // One copy buffer for the whole session; every choice refreshes it from the user's order.
+    arr_copy = deepCopyArray(arr, length);
+    cout << endl;
+
+    do {
+        for (unsigned int i = 0; i < NUM_SORT_ALGORITHMS; i++) {
+            cout << i+1 << ". " << SORT_ALGORITHMS[i].menu_name << endl;
+        }
+        cout << NUM_SORT_ALGORITHMS+1 << ". Exit" << endl;
+        cout << endl;
+
+        do {
+            cout << "Enter your choice (1-" << NUM_SORT_ALGORITHMS+1 << "): ";
+            cin >> user_choice;
+
+            if (isInvalidInput() || user_choice < 1 || user_choice > NUM_SORT_ALGORITHMS+1) {
+                cout << "Invalid input. Please enter an integer between (1-" << NUM_SORT_ALGORITHMS+1 << ")." << endl;
+            }
+            else {
+                break;
+            }
+        } while (true);
+        cout << endl;
+
+        if (user_choice == NUM_SORT_ALGORITHMS+1) {
+            delete[] arr;
+            delete[] arr_copy;
+            return 0;
+        }
+
+        // Every algorithm sorts a fresh copy, so each one starts from the user's order.
+        copyArray(arr_copy, arr, length);
+        SORT_ALGORITHMS[user_choice-1].sort(arr_copy, length, false);
+        printArray(arr_copy, length);
+        cout << endl;
+    } while (true);
+}
+
+/**
+ * @brief Sorts the integers of an input file & writes them to an output file, or sorts an array file in place.
+ *
+ * The input may be text or an array file; an array file is memory-mapped & sorted without copying it.
+ * --binary writes the output as an array file. --in-place sorts an array file on disk
+ * & sets its sorted flag instead of writing an output. --memory sorts an array file of any
+ * size with externalSort, using at most SIZE bytes (suffix K, M or G) of memory.
+ * --stats prints the sort's time & hardware counters (plus comparisons, swaps & moves in builds
+ * with -DDSA_INSTRUMENT) to stderr; see sort_stats.h.
+ *
+ * @param argc, argv Arguments passed to main.
+ *
+ * @return 0, if the sorted integers were written; otherwise, 1 after printing an error to stderr.
+ *
+ * @code
+ * // ./sort --algo=radix --input=data.txt --output=sorted.txt
+ * // ./sort --algo=parallel --threads=16 --desc --input=data.txt
+ * // ./sort --algo=radix --input=data.txt --output=sorted.bin --binary
+ * // ./sort --algo=radix --input=data.bin --in-place
+ * // ./sort --algo=insertion --input=data.txt --output=sorted.txt --stats
+ * // ./sort --algo=radix --input=huge.bin --output=huge_sorted.bin --memory=4G --temp-dir=/scratch
+ * @endcode
+ */
+int runBatchSort(int argc, char* argv[]) {
+    const char* unknown = findUnknownOption(argc, argv, BATCH_OPTIONS);
+    const char* algo = getOption(argc, argv, "algo");
+    const char* input = getOption(argc, argv, "input");
+    const char* output = getOption(argc, argv, "output");
+    const char* threads = getOption(argc, argv, "threads");
+    const bool desc = hasFlag(argc, argv, "desc");
+    const bool binary = hasFlag(argc, argv, "binary");
+    const bool in_place = hasFlag(argc, argv, "in-place");
+    const char* memory = getOption(argc, argv, "memory");
+    const bool show_stats = hasFlag(argc, argv, "stats");
+
+    const SortAlgorithm* algorithm = nullptr;
+    for (unsigned int i = 0; algo && i < NUM_SORT_ALGORITHMS; i++) {
+        if (std::strcmp(algo, SORT_ALGORITHMS[i].cli_name) == 0) {
+            algorithm = &SORT_ALGORITHMS[i];
+        }
+    }
+
+    if (unknown) {
+        cerr << "Error: Unknown option " << unknown << "." << endl;
+        return 1;
+    }
+    if (!algorithm || !input || (in_place && (output || binary || memory)) || (memory && !output)) {
+        cerr << "Usage: " << argv[0] << " --algo=NAME --input=FILE [--output=FILE] [--binary] [--desc] [--threads=N] [--stats]" << endl;
+        cerr << "       " << argv[0] << " --algo=NAME --input=FILE --in-place [--desc] [--threads=N] [--stats]" << endl;
+        cerr << "       " << argv[0] << " --algo=NAME --input=FILE --output=FILE --memory=SIZE [--temp-dir=DIR] [--desc] [--threads=N]" << endl;
+        cerr << "NAME: bubble, selection, insertion, heap, intro, adaptive, stable, radix, parallel" << endl;
+        return 1;
+    }
+    if ((in_place || memory) && !isArrayFile(input)) {
+        cerr << "Error: " << (in_place ? "--in-place" : "--memory") << " needs an array file; convert " << input << " with --binary first." << endl;
+        return 1;
+    }
+
+    if (threads) {
+        batch_threads = std::atoi(threads);
+    }
+
+    if (memory) {
+        int status = externalSort(input, output, parseByteSize(memory), algorithm->sort, desc, getOption(argc, argv, "temp-dir"));
+
+        if (status == -2) {
+            cerr << "Error: --memory must be at least 1M & --output must differ from --input." << endl;
+        }
+        else if (status == -5) {
+            cerr << "Error: " << input << " is not a valid array file." << endl;
+        }
+        else if (status != 0) {
+            cerr << "Error: External sort failed; check the output & temporary directories." << endl;
+        }
+        return status == 0 ? 0 : 1;
+    }
+
+    // Copy-on-write, unless the file itself should be sorted: pages are copied only as the sort writes them.
+    MappedArray array;
+    int status = loadIntegerArray(input, in_place ? ARRAY_FILE_WRITE : ARRAY_FILE_PRIVATE, &array);
+    if (status == -5) {
+        cerr << "Error: " << input << " must hold only whitespace-separated integers, or be a valid array file." << endl;
+        return 1;
+    }
+    if (status != 0) {
+        cerr << "Error: Could not read integers from " << input << "." << endl;
+        return 1;
+    }
+
+    SortStats stats;
+    if (show_stats) {
+        beginStats();
+    }
+
+    sortArrayFile(&array, algorithm->sort, desc);
+
+    if (show_stats) {
+        endStats(&stats);
+        printStats(&stats);
+    }
+
+    if (!in_place) {
+        const char* path = output ? output : "-";
+        status = binary ? writeArrayFile(path, array.data, array.length)
+                        : writeIntegerFile(path, array.data, array.length);
+        if (status != 0) {
+            cerr << "Error: Could not write the sorted integers." << endl;
+        }
+    }
+
+    closeArrayFile(&array);
+    return status == 0 ? 0 : 1;
+}
+
+/**
+ * @brief Parses a size in bytes with an optional K, M or G suffix (powers of 1024).
+ *
+ * @return Size in bytes; 0, if @p text is not a valid size.
+ */
+static size_t parseByteSize(const char* text) {
+    char* end;
+    unsigned long long size = std::strtoull(text, &end, 10);
+
+    if (end == text) {
+        return 0;
+    }
+
+    switch (*end) {
+        case 'K': case 'k': size <<= 10; end++; break;
+        case 'M': case 'm': size <<= 20; end++; break;
+        case 'G': case 'g': size <<= 30; end++; break;
+    }
+
+    return *end == '\0' ? (size_t)size : 0;
+}
@@ -0,0 +1,292 @@
+/**
+ * @file sort_stats.cpp
+ * @brief Per-call instrumentation - Operation counts & hardware performance counters for sorts & searches.
+ *
+ * Provides function definitions for the instrumented calls declared in sort_stats.h.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include "sort_stats.h"
+
+// ====== Measurement ======
+void beginStats();
+void endStats(SortStats*);
+void printStats(const SortStats*);
+bool hardwareCountersAvailable();
+
+// ====== Instrumented Calls ======
+int sortWithStats(void (*sort)(int[], const int, bool), int[], const int, bool, SortStats*);
+int searchWithStats(int (*search)(const int, const int[], const int), const int, const int[], const int, SortStats*);
+
+static const int NUM_HARDWARE_COUNTERS = 4;
+// Order matches the SortStats fields: cycles, instructions, branch_misses, cache_misses.
+static const uint64_t HARDWARE_COUNTER_EVENTS[NUM_HARDWARE_COUNTERS] = {
+    PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_BRANCH_MISSES, PERF_COUNT_HW_CACHE_MISSES
+};
+
+/**
+ * @brief The calling thread's perf counters, opened on first use & kept until the thread exits.
+ *
+ * Opening a counter is a system call, so a thread that calls sortWithStats repeatedly
+ * only pays for resetting, enabling & disabling them. fds[i] is -1 if event i is not
+ * available, e.g. in a virtual machine without a virtual PMU.
+ */
+struct HardwareCounters {
+    int fds[NUM_HARDWARE_COUNTERS];
+    bool opened;
+
+    HardwareCounters() : opened(false) {
+        for (int i = 0; i < NUM_HARDWARE_COUNTERS; i++) {
+            fds[i] = -1;
+        }
+    }
+
+    ~HardwareCounters() {
+        for (int i = 0; i < NUM_HARDWARE_COUNTERS; i++) {
+            if (fds[i] >= 0) {
+                close(fds[i]);
+            }
+        }
+    }
+};
+
+static thread_local HardwareCounters hardware_counters;
+
+// Wall time at which the measurement in progress on this thread began.
+static thread_local std::chrono::steady_clock::time_point stats_start;
+
+
+/**
+ * @brief Opens a disabled counter of a hardware event for the calling thread, in user space only.
+ *
+ * @return File descriptor of the counter; -1, if it could not be opened.
+ */
+static int openHardwareCounter(const uint64_t event) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = event;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    // If the PMU has fewer counters than events, the kernel time-shares them; these let us scale the counts.
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+/**
+ * @brief Opens the calling thread's counters, once.
+ */
+static HardwareCounters& threadHardwareCounters() {
+    HardwareCounters& counters = hardware_counters;
+
+    if (!counters.opened) {
+        for (int i = 0; i < NUM_HARDWARE_COUNTERS; i++) {
+            counters.fds[i] = openHardwareCounter(HARDWARE_COUNTER_EVENTS[i]);
+        }
+        counters.opened = true;
+    }
+
+    return counters;
+}
+
+/**
+ * @brief Reads a stopped counter, scaled up if the kernel time-shared it.
+ *
+ * @return Event count; -1, if the counter is not open, could not be read or never ran.
+ */
+static long long readHardwareCounter(const int fd) {
+    if (fd < 0) {
+        return -1;
+    }
+
+    uint64_t values[3]; // value, time enabled, time running
+    if (read(fd, values, sizeof(values)) != (ssize_t)sizeof(values) || values[2] == 0) {
+        return -1;
+    }
+    if (values[2] < values[1]) {
+        return (long long)((double)values[0] * values[1] / values[2]);
+    }
+
+    return (long long)values[0];
+}
+
+/**
+ * @brief Starts measuring on the calling thread: resets the operation counts & starts the hardware counters & the clock.
+ *
+ * @note Measurements do not nest; every beginStats must be followed by an endStats on the same thread.
+ *
+ * @code
+ * SortStats stats;
+ *
+ * beginStats();
+ * binarySearchBatch(queries, num_queries, view, results);
+ * endStats(&stats);
+ * printStats(&stats);
+ * @endcode
+ */
+void beginStats() {
+    HardwareCounters& counters = threadHardwareCounters();
+
+    CountedInt::comparisons = CountedInt::swaps = CountedInt::moves = 0;
+
+    for (int i = 0; i < NUM_HARDWARE_COUNTERS; i++) {
+        if (counters.fds[i] >= 0) {
+            ioctl(counters.fds[i], PERF_EVENT_IOC_RESET, 0);
+            ioctl(counters.fds[i], PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+
+    stats_start = std::chrono::steady_clock::now();
+}
+
+/**
+ * @brief Stops measuring on the calling thread & fills @p stats with what happened since beginStats.
+ *
+ * @param stats Pointer to the SortStats that receives the measurements. Null only stops the counters.
+ */
+void endStats(SortStats* stats) {
+    auto stats_end = std::chrono::steady_clock::now();
+    HardwareCounters& counters = threadHardwareCounters();
+
+    for (int i = 0; i < NUM_HARDWARE_COUNTERS; i++) {
+        if (counters.fds[i] >= 0) {
+            ioctl(counters.fds[i], PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+
+    if (!stats) {
+        return;
+    }
+
+    stats->elapsed_ns = std::chrono::duration<double, std::nano>(stats_end - stats_start).count();
+    stats->cycles = readHardwareCounter(counters.fds[0]);
+    stats->instructions = readHardwareCounter(counters.fds[1]);
+    stats->branch_misses = readHardwareCounter(counters.fds[2]);
+    stats->cache_misses = readHardwareCounter(counters.fds[3]);
+
+#ifdef DSA_INSTRUMENT
+    stats->comparisons = CountedInt::comparisons;
+    stats->swaps = CountedInt::swaps;
+    stats->moves = CountedInt::moves;
+    stats->counted = true;
+#else
+    stats->comparisons = stats->swaps = stats->moves = 0;
+    stats->counted = false;
+#endif
+}
+
+/**
+ * @brief Sorts an array with one of the sorting functions of sort.h & reports what the call did.
+ *
+ * @param sort Sorting function to call.
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param desc Passed to @p sort.
+ * @param stats Pointer to the SortStats that receives the measurements.
+ *
+ * @return 0, if the array was sorted & @p stats filled.
+ * @return -2, if @p sort, @p arr or @p stats is null or if @p length is a non-positive integer.
+ *
+ * @note Work done on pool threads (parallelMergeSort, the threaded radixSort histogram) is
+ *       not in the hardware or operation counts, which cover the calling thread only.
+ *
+ * @code
+ * SortStats stats;
+ *
+ * sortWithStats(insertionSort, arr, length, false, &stats);
+ * // stats.elapsed_ns, stats.branch_misses, ...; stats.comparisons if built with -DDSA_INSTRUMENT
+ * @endcode
+ */
+int sortWithStats(void (*sort)(int[], const int, bool), int arr[], const int length, const bool desc, SortStats* stats) {
+    if (!sort || !arr || !stats) {
+        return -2;
+    }
+    if (length <= 0) {
+        return -2;
+    }
+
+    beginStats();
+    sort(arr, length, desc);
+    endStats(stats);
+    return 0;
+}
+
+/**
+ * @brief Searches an array with one of the searching functions of search.h & reports what the call did.
+ *
+ * @param search Searching function to call, e.g. linearSearch or binarySearch.
+ * @param value, arr, length Passed to @p search.
+ * @param stats Pointer to the SortStats that receives the measurements. comparisons counts
+ *              the elements the search examined; swaps & moves are 0.
+ *
+ * @return The result of @p search; -2, if @p search or @p stats is null.
+ *
+ * @code
+ * SortStats stats;
+ *
+ * int idx = searchWithStats(binarySearch, 42, sorted_arr, length, &stats);
+ * @endcode
+ */
+int searchWithStats(int (*search)(const int, const int[], const int), const int value, const int arr[],
+                    const int length, SortStats* stats) {
+    if (!search || !stats) {
+        return -2;
+    }
+
+    beginStats();
+    int result = search(value, arr, length);
+    endStats(stats);
+    return result;
+}
+
+/**
+ * @brief Prints the measurements as one line of key=value pairs to stderr, for logs & dashboards.
+ *
+ * Operation counts are printed only if they were counted; hardware counts of -1 were unavailable.
+ *
+ * @code
+ * // ns=183402.0 cycles=512934 instructions=1203311 branch_misses=9120 cache_misses=310 comparisons=24511 swaps=0 moves=27802
+ * @endcode
+ */
+void printStats(const SortStats* stats) {
+    if (!stats) {
+        return;
+    }
+
+    std::fprintf(stderr, "ns=%.1f cycles=%lld instructions=%lld branch_misses=%lld cache_misses=%lld",
+                 stats->elapsed_ns, stats->cycles, stats->instructions, stats->branch_misses, stats->cache_misses);
+    if (stats->counted) {
+        std::fprintf(stderr, " comparisons=%lld swaps=%lld moves=%lld", stats->comparisons, stats->swaps, stats->moves);
+    }
+    std::fprintf(stderr, "\n");
+}
+
+/**
+ * @brief Checks whether the calling thread can read at least one hardware counter.
+ *
+ * @return True, if perf_event_open succeeded for at least one event; otherwise, false.
+ */
+bool hardwareCountersAvailable() {
+    HardwareCounters& counters = threadHardwareCounters();
+
+    for (int i = 0; i < NUM_HARDWARE_COUNTERS; i++) {
+        if (counters.fds[i] >= 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
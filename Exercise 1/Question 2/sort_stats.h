@@ -0,0 +1,104 @@
+/**
+ * @file sort_stats.h
+ * @brief Per-call instrumentation - Operation counts & hardware performance counters for sorts & searches.
+ *
+ * sortWithStats & searchWithStats run one call & fill a SortStats (beginStats & endStats measure
+ * any other stretch of code, e.g. a batch of searches): wall time, plus CPU cycles,
+ * instructions, branch mispredictions & cache misses from Linux perf_event_open when the
+ * kernel allows it (see /proc/sys/kernel/perf_event_paranoid).
+ *
+ * Comparisons, swaps & moves are counted only in builds with -DDSA_INSTRUMENT. The comparison
+ * sorts then run on CountedInt copies of the elements & the searches count their probes.
+ * Without the flag the counting hooks are empty inline functions, so regular builds pay
+ * nothing. Instrumented builds execute extra instructions; take hardware counters from a
+ * regular build when they must match production.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#pragma once
+
+/**
+ * @brief What one sort or search call did.
+ *
+ * Operation counts are valid if counted is set; hardware counts are -1 when the counter could not be opened.
+ */
+struct SortStats {
+    long long comparisons;
+    long long swaps;
+    long long moves;
+
+    long long cycles;
+    long long instructions;
+    long long branch_misses;
+    long long cache_misses;
+
+    double elapsed_ns;
+    bool counted;
+};
+
+/**
+ * @brief Integer that counts the comparisons, swaps & moves a sort performs on it.
+ *
+ * The counters are per thread, so concurrent sorts on different threads do not mix their counts.
+ */
+struct CountedInt {
+    int value;
+
+    inline static thread_local long long comparisons = 0;
+    inline static thread_local long long swaps = 0;
+    inline static thread_local long long moves = 0;
+
+    CountedInt() : value(0) {}
+    CountedInt(const int v) : value(v) {}
+    CountedInt(const CountedInt& other) : value(other.value) { moves++; }
+    CountedInt& operator=(const CountedInt& other) { value = other.value; moves++; return *this; }
+
+    bool operator<(const CountedInt& other) const { comparisons++; return value < other.value; }
+    bool operator>(const CountedInt& other) const { comparisons++; return value > other.value; }
+
+    friend void swap(CountedInt& a, CountedInt& b) {
+        int tmp = a.value;
+        a.value = b.value;
+        b.value = tmp;
+        swaps++;
+    }
+};
+
+/**
+ * @brief Adds @p n to the calling thread's comparison count. Compiles to nothing without DSA_INSTRUMENT.
+ */
+static inline void countComparisons([[maybe_unused]] const long long n) {
+#ifdef DSA_INSTRUMENT
+    CountedInt::comparisons += n;
+#endif
+}
+
+/**
+ * @brief Adds @p n to the calling thread's swap count. Compiles to nothing without DSA_INSTRUMENT.
+ */
+static inline void countSwaps([[maybe_unused]] const long long n) {
+#ifdef DSA_INSTRUMENT
+    CountedInt::swaps += n;
+#endif
+}
+
+/**
+ * @brief Adds @p n to the calling thread's move count. Compiles to nothing without DSA_INSTRUMENT.
+ */
+static inline void countMoves([[maybe_unused]] const long long n) {
+#ifdef DSA_INSTRUMENT
+    CountedInt::moves += n;
+#endif
+}
+
+// ====== Measurement ======
+void beginStats();
+void endStats(SortStats*);
+void printStats(const SortStats*);
+bool hardwareCountersAvailable();
+
+// ====== Instrumented Calls ======
+int sortWithStats(void (*sort)(int[], const int, bool), int[], const int, bool, SortStats*);
+int searchWithStats(int (*search)(const int, const int[], const int), const int, const int[], const int, SortStats*);
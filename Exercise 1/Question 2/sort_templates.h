@@ -0,0 +1,1090 @@
+/**
+ * @file sort_templates.h
+ * @brief Generic sorting algorithms - Bubble Sort, Insertion Sort, Selection Sort, Heap Sort, Intro Sort, Pattern-defeating Quicksort, Partial Sort, Nth Element, Adaptive Sort, Stable Sort.
+ *
+ * Header-only templates over any random-access iterator (or pointer) and comparator.
+ * The comparator is a compile-time parameter, so the ascending/descending choice
+ * is inlined into the inner loops instead of being re-checked on every comparison.
+ * The int-only functions declared in sort.h are thin wrappers around these.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+// Partitions smaller than this are handed to insertionSort.
+constexpr long INTRO_SORT_THRESHOLD = 16;
+// pdqSort partitions smaller than this are handed to insertionSort.
+constexpr long PDQ_INSERTION_THRESHOLD = 24;
+// pdqSort partitions larger than this pick their pivot as the median of three medians.
+constexpr long PDQ_NINTHER_THRESHOLD = 128;
+// Elements partialInsertionSort may move before it gives up on a partition.
+constexpr long PDQ_PARTIAL_INSERTION_LIMIT = 8;
+// adaptiveSort extends natural runs shorter than this with insertion sort.
+constexpr long ADAPTIVE_MIN_RUN = 32;
+// adaptiveSort merges runs only if they average at least this many elements; otherwise it uses pdqSort.
+constexpr long ADAPTIVE_MIN_AVERAGE_RUN = 32;
+// Consecutive wins by one side of a merge after which gallopMerge switches to galloping.
+constexpr long MIN_GALLOP = 7;
+// partialSort heap-selects the prefix when it is at most 1/this of the range; otherwise it uses nthElement.
+constexpr long PARTIAL_SORT_HEAP_RATIO = 16;
+// Pairs of partitions nthElement lets pass without halving the range before it switches to median-of-medians.
+constexpr int NTH_ELEMENT_BAD_ROUNDS = 2;
+
+// ====== Utilities ======
+
+/**
+ * @brief Returns an iterator to the first minimum element in [first, last).
+ *
+ * @param first, last Range to scan.
+ * @param comp Strict weak ordering. (default=std::less<>)
+ *
+ * @return Iterator to the first element that no other element precedes; @p last, if the range is empty.
+ *
+ * @code
+ * long long arr[] = {5, 1, 2, 1, 4};
+ * long long* min = findMin(arr, arr+5); // Points to arr[1]
+ * @endcode
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+RandomIt findMin(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    if (first == last) {
+        return last;
+    }
+
+    RandomIt min = first;
+
+    for (RandomIt it = first + 1; it != last; ++it) {
+        if (comp(*it, *min)) {
+            min = it;
+        }
+    }
+
+    return min;
+}
+
+/**
+ * @brief Returns an iterator to the first maximum element in [first, last).
+ *
+ * @param first, last Range to scan.
+ * @param comp Strict weak ordering. (default=std::less<>)
+ *
+ * @return Iterator to the first element that precedes no other element; @p last, if the range is empty.
+ *
+ * @code
+ * float arr[] = {5.0f, 1.0f, 5.0f};
+ * float* max = findMax(arr, arr+3); // Points to arr[0]
+ * @endcode
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+RandomIt findMax(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    if (first == last) {
+        return last;
+    }
+
+    RandomIt max = first;
+
+    for (RandomIt it = first + 1; it != last; ++it) {
+        if (comp(*max, *it)) {
+            max = it;
+        }
+    }
+
+    return max;
+}
+
+// ====== Sorting Functions ======
+
+/**
+ * @brief Sorts [first, last) using Bubble sort algorithm.
+ *
+ * Stops as soon as a pass makes no swap, so sorted input takes n-1 comparisons.
+ *
+ * @param first, last Range to sort.
+ * @param comp Strict weak ordering; pass std::greater<>() for descending order. (default=std::less<>)
+ *
+ * @code
+ * std::vector<double> v = {5.5, 1.5, 2.5};
+ * bubbleSort(v.begin(), v.end());                   // 1.5 2.5 5.5
+ * bubbleSort(v.begin(), v.end(), std::greater<>()); // 5.5 2.5 1.5
+ * @endcode
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void bubbleSort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    /*
+    In-place Bubble sort.
+    */
+    auto length = last - first;
+
+    // Everything after the last swap of a pass is in place, so the next pass stops there;
+    // a pass without swaps ends the sort, which makes sorted input a single O(n) pass.
+    while (length > 1) {
+        decltype(length) last_swap = 0;
+
+        for (decltype(length) j = 0; j < length-1; j++) {
+            if (comp(first[j+1], first[j])) {
+                std::iter_swap(first+j, first+j+1);
+                last_swap = j+1;
+            }
+        }
+
+        length = last_swap;
+    }
+}
+
+/**
+ * @brief Sorts [first, last) using Selection sort algorithm.
+ *
+ * @param first, last Range to sort.
+ * @param comp Strict weak ordering; pass std::greater<>() for descending order. (default=std::less<>)
+ *
+ * @note Not stable: a swap can carry an element past others equal to it. Use stableSort to keep ties in order.
+ *
+ * @code
+ * long long arr[] = {5, 1, 2, 3, 4};
+ * selectionSort(arr, arr+5); // 1 2 3 4 5
+ * @endcode
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void selectionSort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    /*
+    In-place Selection sort.
+    */
+    if (last - first < 2) {
+        return;
+    }
+
+    for (RandomIt it = first; it != last - 1; ++it) {
+        std::iter_swap(findMin(it, last, comp), it);
+    }
+}
+
+/**
+ * @brief Sorts [first, last) using Insertion sort algorithm.
+ *
+ * @param first, last Range to sort.
+ * @param comp Strict weak ordering; pass std::greater<>() for descending order. (default=std::less<>)
+ *
+ * @code
+ * long long arr[] = {5, 1, 2, 3, 4};
+ * insertionSort(arr, arr+5, std::greater<>()); // 5 4 3 2 1
+ * @endcode
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void insertionSort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    /*
+    In-place Insertion sort.
+    */
+    if (last - first < 2) {
+        return;
+    }
+
+    for (RandomIt it = first + 1; it != last; ++it) {
+        auto tmp = std::move(*it);
+        RandomIt hole = it;
+
+        // Shift the larger elements right instead of swapping them one step at a time.
+        while (hole != first && comp(tmp, *(hole - 1))) {
+            *hole = std::move(*(hole - 1));
+            --hole;
+        }
+        *hole = std::move(tmp);
+    }
+}
+
+/**
+ * @brief Moves the element at @p root down the heap rooted at @p first until the heap property holds.
+ *
+ * @param first Start of the heap.
+ * @param root Offset of the element to sift down.
+ * @param length Number of elements in the heap.
+ * @param comp Strict weak ordering; the element that no other precedes ends up at the top.
+ */
+template <typename RandomIt, typename Compare>
+void heapSiftDown(RandomIt first, typename std::iterator_traits<RandomIt>::difference_type root,
+                  typename std::iterator_traits<RandomIt>::difference_type length, Compare comp) {
+    auto tmp = std::move(first[root]);
+
+    while (true) {
+        auto child = 2*root + 1;
+
+        if (child >= length) {
+            break;
+        }
+        if (child+1 < length && comp(first[child], first[child+1])) {
+            child++;
+        }
+        if (!comp(tmp, first[child])) {
+            break;
+        }
+
+        first[root] = std::move(first[child]);
+        root = child;
+    }
+
+    first[root] = std::move(tmp);
+}
+
+/**
+ * @brief Sorts [first, last) using Heap sort algorithm.
+ *
+ * @param first, last Range to sort.
+ * @param comp Strict weak ordering; pass std::greater<>() for descending order. (default=std::less<>)
+ *
+ * @code
+ * float arr[] = {5.0f, 1.0f, 2.0f};
+ * heapSort(arr, arr+3); // 1 2 5
+ * @endcode
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void heapSort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    /*
+    In-place Heap sort.
+    */
+    auto length = last - first;
+
+    for (auto i = length/2 - 1; i >= 0; i--) {
+        heapSiftDown(first, i, length, comp);
+    }
+
+    for (auto end = length-1; end > 0; end--) {
+        std::iter_swap(first, first+end);
+        heapSiftDown(first, 0, end, comp);
+    }
+}
+
+/**
+ * @brief Returns the iterator to the median of three elements.
+ *
+ * @param a, b, c Iterators to the three candidates.
+ * @param comp Strict weak ordering.
+ */
+template <typename RandomIt, typename Compare>
+RandomIt medianOfThree(RandomIt a, RandomIt b, RandomIt c, Compare comp) {
+    if (comp(*a, *b)) {
+        if (comp(*b, *c)) return b;
+        return comp(*a, *c) ? c : a;
+    }
+    if (comp(*a, *c)) return a;
+    return comp(*b, *c) ? c : b;
+}
+
+/**
+ * @brief Partitions [first, last) around the pivot *first.
+ *
+ * @param first, last Range to partition; must hold at least 1 element.
+ * @param comp Strict weak ordering.
+ *
+ * @return Final position of the pivot. Elements before it do not follow it & elements after it do not precede it.
+ */
+template <typename RandomIt, typename Compare>
+RandomIt hoarePartition(RandomIt first, RandomIt last, Compare comp) {
+    RandomIt i = first;
+    RandomIt j = last;
+
+    while (true) {
+        // Both scans stop on elements equal to the pivot, which keeps duplicates balanced.
+        do { ++i; } while (i != last && comp(*i, *first));
+        do { --j; } while (comp(*first, *j));
+
+        if (i >= j) {
+            break;
+        }
+        std::iter_swap(i, j);
+    }
+
+    std::iter_swap(first, j);
+    return j;
+}
+
+/**
+ * @brief Partitions [first, last) around a median-of-three pivot.
+ *
+ * @param first, last Range to partition; must hold at least 3 elements.
+ * @param comp Strict weak ordering.
+ *
+ * @return Final position of the pivot. Elements before it do not follow it & elements after it do not precede it.
+ */
+template <typename RandomIt, typename Compare>
+RandomIt introSortPartition(RandomIt first, RandomIt last, Compare comp) {
+    std::iter_swap(first, medianOfThree(first, first + (last-first)/2, last-1, comp));
+    return hoarePartition(first, last, comp);
+}
+
+/**
+ * @brief Sorts [first, last) with quicksort, switching to heap sort once @p depth_limit is exhausted.
+ *
+ * @param first, last Range to sort.
+ * @param depth_limit Number of partitioning levels left before falling back to heap sort.
+ * @param comp Strict weak ordering.
+ */
+template <typename RandomIt, typename Compare>
+void introSortLoop(RandomIt first, RandomIt last, int depth_limit, Compare comp) {
+    while (last - first > INTRO_SORT_THRESHOLD) {
+        if (depth_limit == 0) {
+            heapSort(first, last, comp);
+            return;
+        }
+        depth_limit--;
+
+        RandomIt p = introSortPartition(first, last, comp);
+
+        // Recurse into the smaller side & loop on the larger one to bound the stack depth.
+        if (p - first < last - p) {
+            introSortLoop(first, p, depth_limit, comp);
+            first = p + 1;
+        } else {
+            introSortLoop(p + 1, last, depth_limit, comp);
+            last = p;
+        }
+    }
+
+    insertionSort(first, last, comp);
+}
+
+/**
+ * @brief Sorts [first, last) using Intro sort algorithm.
+ *
+ * Median-of-three quicksort that falls back to heap sort when the recursion gets
+ * deeper than 2*log2(n), and hands small partitions to insertion sort.
+ *
+ * @param first, last Range to sort.
+ * @param comp Strict weak ordering; pass std::greater<>() for descending order. (default=std::less<>)
+ *
+ * @code
+ * struct Point { int x, y; };
+ * std::vector<Point> pts = {{3, 1}, {1, 2}};
+ * introSort(pts.begin(), pts.end(), [](const Point& a, const Point& b) { return a.x < b.x; });
+ * @endcode
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void introSort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    /*
+    In-place Intro sort.
+    */
+    int depth_limit = 0;
+    for (auto n = last - first; n > 1; n >>= 1) {
+        depth_limit += 2;
+    }
+
+    introSortLoop(first, last, depth_limit, comp);
+}
+
+// ====== Pattern-defeating Quicksort ======
+
+/**
+ * @brief Orders *a, *b & *c so that *a <= *b <= *c.
+ */
+template <typename RandomIt, typename Compare>
+void sortThree(RandomIt a, RandomIt b, RandomIt c, Compare comp) {
+    if (comp(*b, *a)) std::iter_swap(a, b);
+    if (comp(*c, *b)) std::iter_swap(b, c);
+    if (comp(*b, *a)) std::iter_swap(a, b);
+}
+
+/**
+ * @brief Insertion sort that gives up once it has moved more than PDQ_PARTIAL_INSERTION_LIMIT elements.
+ *
+ * @return True, if [first, last) is now sorted; false, if it gave up.
+ */
+template <typename RandomIt, typename Compare>
+bool partialInsertionSort(RandomIt first, RandomIt last, Compare comp) {
+    if (first == last) {
+        return true;
+    }
+
+    long moved = 0;
+
+    for (RandomIt cur = first + 1; cur != last; ++cur) {
+        if (!comp(*cur, *(cur-1))) {
+            continue;
+        }
+
+        auto tmp = std::move(*cur);
+        RandomIt hole = cur;
+
+        do {
+            *hole = std::move(*(hole-1));
+            --hole;
+        } while (hole != first && comp(tmp, *(hole-1)));
+
+        *hole = std::move(tmp);
+        moved += cur - hole;
+
+        if (moved > PDQ_PARTIAL_INSERTION_LIMIT) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief Partitions [first, last) around the pivot *first; elements equal to the pivot go to the right.
+ *
+ * @note Some element after the first must not be less than the pivot; the pivot selection guarantees it.
+ *
+ * @return Final position of the pivot, & whether the range was already partitioned (no swap was needed).
+ */
+template <typename RandomIt, typename Compare>
+std::pair<RandomIt, bool> pdqPartitionRight(RandomIt first, RandomIt last, Compare comp) {
+    auto pivot = std::move(*first);
+    RandomIt i = first;
+    RandomIt j = last;
+
+    while (comp(*++i, pivot));
+
+    // Without an element less than the pivot on the left, the scan from the right needs a bound.
+    if (i - 1 == first) {
+        while (i < j && !comp(*--j, pivot));
+    } else {
+        while (!comp(*--j, pivot));
+    }
+
+    bool already_partitioned = i >= j;
+
+    while (i < j) {
+        std::iter_swap(i, j);
+        while (comp(*++i, pivot));
+        while (!comp(*--j, pivot));
+    }
+
+    RandomIt pivot_pos = i - 1;
+    *first = std::move(*pivot_pos);
+    *pivot_pos = std::move(pivot);
+    return std::make_pair(pivot_pos, already_partitioned);
+}
+
+/**
+ * @brief Partitions [first, last) around the pivot *first; elements equal to the pivot go to the left.
+ *
+ * Used when the element before the range equals the pivot: no element of the range is smaller,
+ * so the equal elements end up in place on the left & are never touched again.
+ *
+ * @return Final position of the pivot.
+ */
+template <typename RandomIt, typename Compare>
+RandomIt pdqPartitionLeft(RandomIt first, RandomIt last, Compare comp) {
+    // A copy, not a move, so *first still stops the unguarded scan below.
+    const auto pivot = *first;
+    RandomIt i = first;
+    RandomIt j = last;
+
+    while (comp(pivot, *--j));
+
+    if (j + 1 == last) {
+        while (i < j && !comp(pivot, *++i));
+    } else {
+        while (!comp(pivot, *++i));
+    }
+
+    while (i < j) {
+        std::iter_swap(i, j);
+        while (comp(pivot, *--j));
+        while (!comp(pivot, *++i));
+    }
+
+    *first = std::move(*j);
+    *j = pivot;
+    return j;
+}
+
+/**
+ * @brief Swaps a few elements of a badly unbalanced partition with elements further in, to break up the pattern that caused it.
+ */
+template <typename RandomIt>
+void pdqBreakPatterns(RandomIt first, RandomIt last) {
+    auto size = last - first;
+
+    if (size < PDQ_INSERTION_THRESHOLD) {
+        return;
+    }
+
+    std::iter_swap(first, first + size/4);
+    std::iter_swap(last-1, last - size/4);
+
+    if (size > PDQ_NINTHER_THRESHOLD) {
+        std::iter_swap(first+1, first + (size/4 + 1));
+        std::iter_swap(first+2, first + (size/4 + 2));
+        std::iter_swap(last-2, last - (size/4 + 1));
+        std::iter_swap(last-3, last - (size/4 + 2));
+    }
+}
+
+/**
+ * @brief Sorts [first, last) with pattern-defeating quicksort.
+ *
+ * @param first, last Range to sort.
+ * @param comp Strict weak ordering.
+ * @param bad_allowed Number of badly unbalanced partitions left before falling back to heap sort.
+ * @param leftmost Whether the range starts the whole array; otherwise, the element before it is a pivot not greater than any of it.
+ */
+template <typename RandomIt, typename Compare>
+void pdqSortLoop(RandomIt first, RandomIt last, Compare comp, int bad_allowed, bool leftmost) {
+    while (true) {
+        auto size = last - first;
+
+        if (size < PDQ_INSERTION_THRESHOLD) {
+            insertionSort(first, last, comp);
+            return;
+        }
+
+        // Move the pivot to *first: median of three, or the median of three medians for large ranges.
+        auto half = size / 2;
+        if (size > PDQ_NINTHER_THRESHOLD) {
+            sortThree(first, first + half, last - 1, comp);
+            sortThree(first + 1, first + (half - 1), last - 2, comp);
+            sortThree(first + 2, first + (half + 1), last - 3, comp);
+            sortThree(first + (half - 1), first + half, first + (half + 1), comp);
+            std::iter_swap(first, first + half);
+        } else {
+            sortThree(first + half, first, last - 1, comp);
+        }
+
+        // The pivot equals its predecessor, a previous pivot: put the run of equal elements in place.
+        if (!leftmost && !comp(*(first-1), *first)) {
+            first = pdqPartitionLeft(first, last, comp) + 1;
+            continue;
+        }
+
+        auto [pivot, already_partitioned] = pdqPartitionRight(first, last, comp);
+        auto left_size = pivot - first;
+        auto right_size = last - (pivot + 1);
+
+        if (left_size < size/8 || right_size < size/8) {
+            if (--bad_allowed == 0) {
+                heapSort(first, last, comp);
+                return;
+            }
+            pdqBreakPatterns(first, pivot);
+            pdqBreakPatterns(pivot + 1, last);
+        }
+        // A partition that needed no swap is probably sorted already; check cheaply before recursing.
+        else if (already_partitioned && partialInsertionSort(first, pivot, comp) &&
+                 partialInsertionSort(pivot + 1, last, comp)) {
+            return;
+        }
+
+        // Recurse into the smaller side & loop on the larger one to bound the stack depth.
+        if (left_size < right_size) {
+            pdqSortLoop(first, pivot, comp, bad_allowed, leftmost);
+            first = pivot + 1;
+            leftmost = false;
+        } else {
+            pdqSortLoop(pivot + 1, last, comp, bad_allowed, false);
+            last = pivot;
+        }
+    }
+}
+
+/**
+ * @brief Sorts [first, last) using Pattern-defeating Quicksort.
+ *
+ * Quicksort with a median-of-three (ninther for large ranges) pivot that detects & exploits
+ * patterns: a partition that needed no swaps is finished with a bounded insertion sort, runs
+ * of elements equal to an earlier pivot are put in place in one linear pass, and badly
+ * unbalanced partitions shuffle a few elements; after log2(n) of those it switches to heap
+ * sort. Runs in O(n log n) in the worst case & O(n) on sorted input or few distinct values.
+ *
+ * @param first, last Range to sort.
+ * @param comp Strict weak ordering; pass std::greater<>() for descending order. (default=std::less<>)
+ *
+ * @code
+ * std::vector<int> v = {5, 1, 2, 3, 4};
+ * pdqSort(v.begin(), v.end()); // 1 2 3 4 5
+ * @endcode
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void pdqSort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    /*
+    In-place Pattern-defeating Quicksort.
+    */
+    int bad_allowed = 0;
+    for (auto n = last - first; n > 1; n >>= 1) {
+        bad_allowed++;
+    }
+
+    if (last - first > 1) {
+        pdqSortLoop(first, last, comp, bad_allowed, true);
+    }
+}
+
+// ====== Selection ======
+
+template <typename RandomIt, typename Compare>
+void medianOfMediansSelect(RandomIt first, RandomIt nth, RandomIt last, Compare comp);
+
+/**
+ * @brief Returns an element of [first, last) whose rank is between 30% & 70%, in O(n) comparisons.
+ *
+ * Sorts each group of 5 elements, gathers the group medians at the front of the range &
+ * selects their median with medianOfMediansSelect. Permutes the range.
+ *
+ * @param first, last Range to pick from; must not be empty.
+ * @param comp Strict weak ordering.
+ */
+template <typename RandomIt, typename Compare>
+RandomIt medianOfMedians(RandomIt first, RandomIt last, Compare comp) {
+    auto length = last - first;
+    RandomIt medians_end = first;
+
+    for (decltype(length) g = 0; g < length; g += 5) {
+        RandomIt group = first + g;
+        RandomIt group_end = first + std::min<decltype(length)>(g + 5, length);
+
+        insertionSort(group, group_end, comp);
+        std::iter_swap(medians_end++, group + (group_end - group - 1)/2);
+    }
+
+    RandomIt median = first + (medians_end - first - 1)/2;
+    medianOfMediansSelect(first, median, medians_end, comp);
+    return median;
+}
+
+/**
+ * @brief Partially sorts [first, last) like nthElement, using median-of-medians pivots only.
+ *
+ * O(n) comparisons in the worst case, but with a constant several times that of quickselect.
+ */
+template <typename RandomIt, typename Compare>
+void medianOfMediansSelect(RandomIt first, RandomIt nth, RandomIt last, Compare comp) {
+    while (last - first > INTRO_SORT_THRESHOLD) {
+        std::iter_swap(first, medianOfMedians(first, last, comp));
+        RandomIt p = hoarePartition(first, last, comp);
+
+        if (p == nth) {
+            return;
+        }
+        if (nth < p) {
+            last = p;
+        } else {
+            first = p + 1;
+        }
+    }
+
+    insertionSort(first, last, comp);
+}
+
+/**
+ * @brief Rearranges [first, last) so that *nth is the element a full sort would put there.
+ *
+ * Elements before @p nth do not follow it & elements after it do not precede it. Introselect:
+ * quickselect with median-of-three pivots, which keeps only the side holding @p nth and takes
+ * O(n) on average. Every two partitions must halve the range; after NTH_ELEMENT_BAD_ROUNDS
+ * pairs that do not, it switches to median-of-medians pivots. Each pair costs at most twice
+ * the range it starts on, so the quickselect part is O(n) too & so is the worst case.
+ *
+ * @param first, last Range to partially sort.
+ * @param nth Position to fill; nothing happens if it is @p last.
+ * @param comp Strict weak ordering; pass std::greater<>() to select in descending order. (default=std::less<>)
+ *
+ * @code
+ * std::vector<int> v = {9, 1, 8, 2, 7, 3};
+ * nthElement(v.begin(), v.begin() + 2, v.end()); // v[2] = 3; v[0..2) holds 1 & 2 in some order
+ * @endcode
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void nthElement(RandomIt first, RandomIt nth, RandomIt last, Compare comp = Compare()) {
+    /*
+    In-place Introselect.
+    */
+    if (nth == last) {
+        return;
+    }
+
+    // Length of the range two partitions ago. Counting partitions alone would let an adversary
+    // shave a few elements off per partition & take Theta(n log n) before the fallback.
+    auto checked_length = last - first;
+    int partitions = 0;
+    int bad_allowed = NTH_ELEMENT_BAD_ROUNDS;
+
+    while (last - first > INTRO_SORT_THRESHOLD) {
+        if (partitions == 2) {
+            if (last - first > checked_length / 2 && bad_allowed-- == 0) {
+                medianOfMediansSelect(first, nth, last, comp);
+                return;
+            }
+            checked_length = last - first;
+            partitions = 0;
+        }
+        partitions++;
+
+        RandomIt p = introSortPartition(first, last, comp);
+
+        if (p == nth) {
+            return;
+        }
+        if (nth < p) {
+            last = p;
+        } else {
+            first = p + 1;
+        }
+    }
+
+    insertionSort(first, last, comp);
+}
+
+/**
+ * @brief Sorts the first (middle - first) elements of [first, last) into place, leaving the rest in unspecified order.
+ *
+ * For a short prefix, heap-selects it: a heap of the first k elements, topped by the worst,
+ * that each later element enters only if it beats the top. Most elements cost a single
+ * comparison, so it is O(n log k) but close to one pass. Otherwise, selects the boundary
+ * with nthElement & sorts only the k elements in front of it with pdqSort: O(n + k log k).
+ * Either beats the O(n log n) of a full sort & the O(n*k) of k rounds of selection sort.
+ *
+ * @param first, last Range to partially sort.
+ * @param middle End of the prefix to sort.
+ * @param comp Strict weak ordering; pass std::greater<>() for the largest elements, in descending order. (default=std::less<>)
+ *
+ * @code
+ * std::vector<int> v = {9, 1, 8, 2, 7, 3};
+ * partialSort(v.begin(), v.begin() + 3, v.end()); // v = {1, 2, 3, ...}
+ * partialSort(v.begin(), v.begin() + 2, v.end(), std::greater<>()); // v = {9, 8, ...}
+ * @endcode
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void partialSort(RandomIt first, RandomIt middle, RandomIt last, Compare comp = Compare()) {
+    if (middle == first) {
+        return;
+    }
+
+    auto k = middle - first;
+
+    if (k > (last - first) / PARTIAL_SORT_HEAP_RATIO) {
+        nthElement(first, middle - 1, last, comp);
+        pdqSort(first, middle - 1, comp);
+        return;
+    }
+
+    for (auto i = k/2 - 1; i >= 0; i--) {
+        heapSiftDown(first, i, k, comp);
+    }
+
+    for (RandomIt it = middle; it != last; ++it) {
+        if (comp(*it, *first)) {
+            std::iter_swap(it, first);
+            heapSiftDown(first, 0, k, comp);
+        }
+    }
+
+    for (auto end = k-1; end > 0; end--) {
+        std::iter_swap(first, first + end);
+        heapSiftDown(first, 0, end, comp);
+    }
+}
+
+// ====== Adaptive Sort ======
+
+/**
+ * @brief Returns the first element of [first, last) for which @p pred is false, probing 1, 3, 7, ... elements from one end.
+ *
+ * Costs O(log k) comparisons when the answer is k elements from the starting end, instead of
+ * O(log n) for a plain binary search.
+ *
+ * @param first, last Range partitioned by @p pred: every element that satisfies it comes first.
+ * @param pred Predicate the range is partitioned by.
+ * @param from_right If true, probes from @p last backwards; otherwise, from @p first forwards.
+ */
+template <typename RandomIt, typename Pred>
+RandomIt gallopPartitionPoint(RandomIt first, RandomIt last, Pred pred, bool from_right) {
+    auto length = last - first;
+    decltype(length) prev = 0;
+    decltype(length) probe = 1;
+
+    if (!from_right) {
+        while (probe <= length && pred(first[probe-1])) {
+            prev = probe;
+            probe = 2*probe + 1;
+        }
+        return std::partition_point(first + prev, first + std::min(probe, length), pred);
+    }
+
+    while (probe <= length && !pred(last[-probe])) {
+        prev = probe;
+        probe = 2*probe + 1;
+    }
+    return std::partition_point(last - std::min(probe, length), last - prev, pred);
+}
+
+/**
+ * @brief Merges the adjacent sorted runs [first, middle) & [middle, last) in place, galloping through long streaks.
+ *
+ * Elements already in their final place at either end are skipped with a gallop first. The
+ * smaller remaining run is moved to @p buffer & merged from the matching end. When one run
+ * wins MIN_GALLOP times in a row, the merge gallops to the end of that streak & moves it in
+ * one block. Ties take the element of the left run first, so the merge is stable.
+ *
+ * @param first, middle, last Bounds of the two runs.
+ * @param buffer Scratch space for at least min(middle-first, last-middle) elements.
+ * @param comp Strict weak ordering.
+ */
+template <typename RandomIt, typename T, typename Compare>
+void gallopMerge(RandomIt first, RandomIt middle, RandomIt last, T* buffer, Compare comp) {
+    if (first == middle || middle == last) {
+        return;
+    }
+
+    // Left elements not greater than the right's first, & right elements not less than the left's last, stay put.
+    first = gallopPartitionPoint(first, middle, [&](const auto& x) { return !comp(*middle, x); }, false);
+    if (first == middle) {
+        return;
+    }
+    last = gallopPartitionPoint(middle, last, [&](const auto& x) { return comp(x, *(middle-1)); }, true);
+
+    long left_wins = 0, right_wins = 0;
+
+    if (middle - first <= last - middle) {
+        // Merge forwards from the left, with the left run in the buffer.
+        T* b = buffer;
+        T* b_end = std::move(first, middle, buffer);
+        RandomIt r = middle;
+        RandomIt out = first;
+
+        while (b != b_end && r != last) {
+            if (comp(*r, *b)) {
+                *out++ = std::move(*r++);
+                left_wins = 0;
+                if (++right_wins >= MIN_GALLOP) {
+                    RandomIt stop = gallopPartitionPoint(r, last, [&](const auto& x) { return comp(x, *b); }, false);
+                    out = std::move(r, stop, out);
+                    r = stop;
+                    right_wins = 0;
+                }
+            } else {
+                *out++ = std::move(*b++);
+                right_wins = 0;
+                if (++left_wins >= MIN_GALLOP) {
+                    T* stop = gallopPartitionPoint(b, b_end, [&](const auto& x) { return !comp(*r, x); }, false);
+                    out = std::move(b, stop, out);
+                    b = stop;
+                    left_wins = 0;
+                }
+            }
+        }
+
+        std::move(b, b_end, out);
+    } else {
+        // Merge backwards from the right, with the right run in the buffer.
+        T* b = buffer;
+        T* b_end = std::move(middle, last, buffer);
+        RandomIt l = middle;
+        RandomIt out = last;
+
+        while (b != b_end && l != first) {
+            if (comp(*(b_end-1), *(l-1))) {
+                *--out = std::move(*--l);
+                right_wins = 0;
+                if (++left_wins >= MIN_GALLOP) {
+                    RandomIt stop = gallopPartitionPoint(first, l, [&](const auto& x) { return !comp(*(b_end-1), x); }, true);
+                    out = std::move_backward(stop, l, out);
+                    l = stop;
+                    left_wins = 0;
+                }
+            } else {
+                *--out = std::move(*--b_end);
+                left_wins = 0;
+                if (++right_wins >= MIN_GALLOP) {
+                    T* stop = gallopPartitionPoint(b, b_end, [&](const auto& x) { return comp(x, *(l-1)); }, true);
+                    out = std::move_backward(stop, b_end, out);
+                    b_end = stop;
+                    right_wins = 0;
+                }
+            }
+        }
+
+        std::move_backward(b, b_end, out);
+    }
+}
+
+/**
+ * @brief Returns the end of the run that starts at @p first without changing it.
+ *
+ * A run is a non-descending or a strictly descending sequence; strictness keeps reversals stable.
+ *
+ * @param descending Receives whether the run is strictly descending.
+ */
+template <typename RandomIt, typename Compare>
+RandomIt scanRun(RandomIt first, RandomIt last, Compare comp, bool* descending) {
+    RandomIt it = first + 1;
+
+    *descending = it != last && comp(*it, *first);
+    if (*descending) {
+        while (it != last && comp(*it, *(it-1))) ++it;
+    } else {
+        while (it != last && !comp(*it, *(it-1))) ++it;
+    }
+
+    return it;
+}
+
+/**
+ * @brief Counts the natural runs of [first, last), as split by scanRun.
+ *
+ * @param max_runs Count after which to stop; the range is not scanned further.
+ *
+ * @return Number of runs; @p max_runs + 1, if there are more than @p max_runs.
+ */
+template <typename RandomIt, typename Compare>
+size_t countRuns(RandomIt first, RandomIt last, Compare comp, size_t max_runs) {
+    size_t num_runs = 0;
+    bool descending;
+
+    for (RandomIt it = first; it != last && num_runs <= max_runs; it = scanRun(it, last, comp, &descending)) {
+        num_runs++;
+    }
+
+    return num_runs;
+}
+
+/**
+ * @brief Sorts [first, last) by merging its natural runs, which takes O(n) on sorted or reversed input.
+ *
+ * Splits the input into non-descending & strictly descending runs, reversing the latter,
+ * extends runs shorter than ADAPTIVE_MIN_RUN elements with insertion sort and merges
+ * adjacent runs pairwise with gallopMerge. Every step keeps equal elements in input order.
+ *
+ * @param first, last Range to sort; holds r runs, as counted by countRuns.
+ * @param comp Strict weak ordering.
+ * @param bounds Room for r + 1 run boundaries. Extending a run never adds runs after it.
+ * @param buffer Room for (last - first)/2 + 1 elements if r > 1; otherwise, unused.
+ */
+template <typename RandomIt, typename T, typename Compare>
+void mergeNaturalRuns(RandomIt first, RandomIt last, Compare comp,
+                      typename std::iterator_traits<RandomIt>::difference_type* bounds, T* buffer) {
+    using Diff = typename std::iterator_traits<RandomIt>::difference_type;
+
+    size_t num_bounds = 0;
+    bounds[num_bounds++] = 0;
+
+    for (RandomIt it = first; it != last; ) {
+        bool descending;
+        RandomIt run_end = scanRun(it, last, comp, &descending);
+        if (descending) {
+            std::reverse(it, run_end);
+        }
+        if (run_end - it < ADAPTIVE_MIN_RUN) {
+            run_end = it + std::min<Diff>(ADAPTIVE_MIN_RUN, last - it);
+            insertionSort(it, run_end, comp);
+        }
+
+        it = run_end;
+        bounds[num_bounds++] = it - first;
+    }
+
+    // Merge adjacent pairs of runs until one run is left.
+    while (num_bounds > 2) {
+        size_t merged = 1;
+
+        for (size_t i = 0; i + 2 < num_bounds; i += 2) {
+            gallopMerge(first + bounds[i], first + bounds[i+1], first + bounds[i+2], buffer, comp);
+            bounds[merged++] = bounds[i+2];
+        }
+        // An odd run out is carried into the next round unchanged.
+        if (num_bounds % 2 == 0) {
+            bounds[merged++] = bounds[num_bounds-1];
+        }
+
+        num_bounds = merged;
+    }
+}
+
+/**
+ * @brief Allocates the run boundaries & merge buffer for mergeNaturalRuns & merges the runs.
+ *
+ * @param num_runs Number of runs, from countRuns. Sorted or reversed input needs no buffer.
+ */
+template <typename RandomIt, typename Compare>
+void mergeNaturalRunsAllocated(RandomIt first, RandomIt last, Compare comp, size_t num_runs) {
+    using Diff = typename std::iterator_traits<RandomIt>::difference_type;
+    using Value = typename std::iterator_traits<RandomIt>::value_type;
+
+    std::vector<Diff> bounds(num_runs + 1);
+    std::vector<Value> buffer(num_runs > 1 ? (last - first)/2 + 1 : 0);
+
+    mergeNaturalRuns(first, last, comp, bounds.data(), buffer.data());
+}
+
+/**
+ * @brief Sorts [first, last) using an adaptive merge sort over the natural runs of the input.
+ *
+ * Counts the non-descending & strictly descending runs of the input. If they average fewer
+ * than ADAPTIVE_MIN_AVERAGE_RUN elements, which is the case for random data, the count stops
+ * early & the range is sorted with pdqSort. Otherwise the runs are merged with
+ * mergeNaturalRuns. Sorted & reversed input take one O(n) pass; input made of r sorted runs
+ * takes O(n log r).
+ *
+ * @param first, last Range to sort.
+ * @param comp Strict weak ordering; pass std::greater<>() for descending order. (default=std::less<>)
+ *
+ * @note Merging needs a buffer of n/2 elements of a default-constructible type; std::bad_alloc
+ *       propagates if it cannot be allocated, with the range still a permutation of the input.
+ * @note Not stable when it falls back to pdqSort; use stableSort to keep equal elements in order.
+ *
+ * @code
+ * std::vector<int> v = {1, 3, 5, 7, 2, 4, 6, 8};
+ * adaptiveSort(v.begin(), v.end()); // Two runs, one merge: 1 2 3 4 5 6 7 8
+ * @endcode
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void adaptiveSort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    /*
+    In-place Adaptive merge sort (pdqSort on random data).
+    */
+    auto length = last - first;
+    if (length < ADAPTIVE_MIN_RUN) {
+        insertionSort(first, last, comp);
+        return;
+    }
+
+    // Count the runs first, giving up as soon as they are too short on average to be worth merging.
+    size_t max_runs = length / ADAPTIVE_MIN_AVERAGE_RUN;
+    size_t num_runs = countRuns(first, last, comp, max_runs);
+
+    if (num_runs > max_runs) {
+        pdqSort(first, last, comp);
+        return;
+    }
+
+    mergeNaturalRunsAllocated(first, last, comp, num_runs);
+}
+
+/**
+ * @brief Sorts [first, last) using a stable natural merge sort; equal elements keep their input order.
+ *
+ * Same run merging as adaptiveSort, without the pdqSort fallback: O(n log n) on random data,
+ * O(n) on sorted or reversed input.
+ *
+ * @param first, last Range to sort.
+ * @param comp Strict weak ordering; pass std::greater<>() for descending order. (default=std::less<>)
+ *
+ * @note Needs a buffer of n/2 elements of a default-constructible type; std::bad_alloc
+ *       propagates if it cannot be allocated.
+ *
+ * @code
+ * struct Record { int key; const char* name; };
+ * std::vector<Record> v = {{2, "b"}, {1, "x"}, {2, "a"}};
+ * stableSort(v.begin(), v.end(), [](const Record& a, const Record& b) { return a.key < b.key; });
+ * // {1, "x"}, {2, "b"}, {2, "a"}
+ * @endcode
+ */
+template <typename RandomIt, typename Compare = std::less<>>
+void stableSort(RandomIt first, RandomIt last, Compare comp = Compare()) {
+    /*
+    Stable natural Merge sort.
+    */
+    if (last - first < 2) {
+        return;
+    }
+
+    mergeNaturalRunsAllocated(first, last, comp, countRuns(first, last, comp, SIZE_MAX));
+}
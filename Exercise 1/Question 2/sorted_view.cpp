@@ -0,0 +1,123 @@
+/**
+ * @file sorted_view.cpp
+ * @brief Read-only view of an int array that is known to be sorted in ascending order.
+ * 
+ * Provides function definitions for SortedView & the functions that create it.
+ * 
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <cassert>
+#include <cstddef>
+#include "sort.h"
+#include "search.h"
+#include "sorted_view.h"
+
+// ====== View Constructors ======
+int makeSortedView(const int[], const int, SortedView*);
+SortedView sortToView(int[], const int, void (*sort)(int[], const int, bool));
+
+
+/**
+ * @brief Creates an empty view.
+ */
+SortedView::SortedView() : data_(nullptr), length_(0) {
+}
+
+/**
+ * @brief Creates a view of @p length elements at @p data. Only the friend constructors may vouch for sortedness.
+ */
+SortedView::SortedView(const int* data, const int length) : data_(data), length_(length) {
+}
+
+/**
+ * @brief Returns a pointer to the first element of the sorted array.
+ */
+const int* SortedView::data() const {
+    return data_;
+}
+
+/**
+ * @brief Returns the number of elements in the sorted array.
+ */
+int SortedView::length() const {
+    return length_;
+}
+
+/**
+ * @brief Returns true if the view holds no elements.
+ */
+bool SortedView::empty() const {
+    return data_ == nullptr || length_ <= 0;
+}
+
+/**
+ * @brief Checks once that the array is sorted in ascending order & returns a view of it.
+ * 
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param view Pointer to the view that receives the array.
+ * 
+ * @return 0, if @p view now refers to the array.
+ * @return -2, if @p arr or @p view is null or if @p length is a non-positive integer.
+ * @return -3, if @p arr is not sorted in ascending order.
+ * 
+ * @code
+ * int sorted_arr[] = {1, 2, 3, 4, 5};
+ * SortedView view;
+ * 
+ * makeSortedView(sorted_arr, 5, &view); // Returns 0
+ * binarySearch(4, view); // Returns 3
+ * @endcode
+ */
+int makeSortedView(const int arr[], const int length, SortedView* view) {
+    if (arr == NULL || view == NULL) {
+        return -2;
+    }
+    if (length <= 0) {
+        return -2;
+    }
+    if (!isSorted(arr, length)) {
+        return -3;
+    }
+
+    *view = SortedView(arr, length);
+    return 0;
+}
+
+/**
+ * @brief Sorts the array in ascending order & returns a view of it.
+ * 
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param sort Sorting function from sort.h to use. If null, uses introSort. (default=nullptr)
+ *             Builds without NDEBUG assert that it sorted the array.
+ * 
+ * @return View of the sorted array; an empty view, if @p arr is null or if @p length is a non-positive integer.
+ * 
+ * @code
+ * int arr[] = {5, 1, 2, 3, 4};
+ * 
+ * SortedView view = sortToView(arr, 5); // arr = {1, 2, 3, 4, 5}
+ * SortedView view = sortToView(arr, 5, insertionSort);
+ * @endcode
+ */
+SortedView sortToView(int arr[], const int length, void (*sort)(int[], const int, bool)) {
+    if (arr == NULL) {
+        return SortedView();
+    }
+    if (length <= 0) {
+        return SortedView();
+    }
+
+    if (sort) {
+        sort(arr, length, false);
+    } else {
+        introSort(arr, length);
+    }
+    // The view vouches for the order to every search, so a callback that did not sort must not get one.
+    assert(isSorted(arr, length) == 1);
+
+    return SortedView(arr, length);
+}
@@ -0,0 +1,40 @@
+/**
+ * @file sorted_view.h
+ * @brief Read-only view of an int array that is known to be sorted in ascending order.
+ * 
+ * A SortedView can only be obtained from a function that sorted the array, checked
+ * it once or read an array file's sorted flag, so searches that take a view skip
+ * the O(n) isSorted scan on every call.
+ * 
+ * @note The view does not own the array. Modifying the array invalidates the view.
+ * 
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#pragma once
+
+struct MappedArray;
+
+class SortedView {
+public:
+    SortedView();
+
+    const int* data() const;
+    int length() const;
+    bool empty() const;
+
+private:
+    SortedView(const int* data, const int length);
+
+    const int* data_;
+    int length_;
+
+    friend int makeSortedView(const int[], const int, SortedView*);
+    friend SortedView sortToView(int[], const int, void (*)(int[], const int, bool));
+    friend int viewArrayFile(const MappedArray*, SortedView*);
+};
+
+// ====== View Constructors ======
+int makeSortedView(const int[], const int, SortedView*);
+SortedView sortToView(int[], const int, void (*sort)(int[], const int, bool)=nullptr);
@@ -0,0 +1,62 @@
+/**
+ * @file span_api.h
+ * @brief 64-bit sorting & searching API - std::span lengths, size_t indices, std::optional results.
+ *
+ * Counterpart of sort.h & search.h for arrays of more than INT_MAX elements. The span carries
+ * the length, so there is no null/length error code; a search that finds nothing returns
+ * std::nullopt instead of -1. Indices are size_t, so the hot loops count with unsigned
+ * 64-bit indices & need no signed-overflow guards. The int functions in sort.h & search.h
+ * remain for existing callers. Requires C++20.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <span>
+#include <utility>
+
+namespace dsa {
+
+// ====== Utilities ======
+std::optional<size_t> findMinIdx(std::span<const int>);
+std::optional<size_t> findMaxIdx(std::span<const int>);
+std::optional<std::pair<size_t, size_t>> findMinMaxIdx(std::span<const int>);
+bool isSorted(std::span<const int>, bool desc=false);
+
+// ====== Sorting Functions ======
+void bubbleSort(std::span<int>, bool desc=false);
+void insertionSort(std::span<int>, bool desc=false);
+void selectionSort(std::span<int>, bool desc=false);
+void heapSort(std::span<int>, bool desc=false);
+void introSort(std::span<int>, bool desc=false);
+void adaptiveSort(std::span<int>, bool desc=false);
+void stableSort(std::span<int>, bool desc=false);
+void radixSort(std::span<int>, bool desc=false, int num_threads=0);
+void parallelMergeSort(std::span<int>, bool desc=false, int num_threads=0);
+
+// ====== Selection Functions ======
+void partialSort(std::span<int>, size_t, bool desc=false);
+void nthElement(std::span<int>, size_t, bool desc=false);
+
+// ====== Searching Functions ======
+std::optional<size_t> linearSearch(const int, std::span<const int>);
+size_t linearSearchCount(const int, std::span<const int>);
+size_t linearSearchAll(const int, std::span<const int>, std::span<size_t>);
+std::optional<size_t> binarySearch(const int, std::span<const int>);
+size_t branchlessLowerBound(const int, std::span<const int>);
+
+// ====== Range Queries ======
+size_t lowerBound(const int, std::span<const int>);
+size_t upperBound(const int, std::span<const int>);
+std::pair<size_t, size_t> equalRange(const int, std::span<const int>);
+size_t countInRange(const int, const int, std::span<const int>);
+
+// ====== Interpolation & Exponential Search ======
+std::optional<size_t> interpolationSearch(const int, std::span<const int>);
+std::optional<size_t> exponentialSearch(const int, std::span<const int>);
+
+}
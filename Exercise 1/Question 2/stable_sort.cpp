@@ -0,0 +1,218 @@
+/**
+ * @file stable_sort.cpp
+ * @brief Stable sorting algorithms - Stable Sort, Argsort, Sort by key.
+ *
+ * Provides function definitions for the stable sorts declared in sort.h. Argsort & sort by
+ * key pack each key & its index into one 64-bit composite key: the order-preserving bits of
+ * the key in the high word, the index in the low word. Composite keys are unique, & equal
+ * keys compare by index, so sorting them is stable by construction, compares plain integers
+ * with no indirection & moves 8 bytes per element.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include "scratch_arena.h"
+#include "sort.h"
+
+// ====== Stable Sorting Functions ======
+void stableSort(int[], const int, bool desc);
+int argSort(const int[], const int, int[], bool desc);
+int sortByKey(int[], int[], const int, bool desc);
+
+static const int KEY_BITS = 8;
+static const int KEY_BUCKETS = 1 << KEY_BITS;
+static const int KEY_PASSES = 32 / KEY_BITS;
+
+
+/**
+ * @brief Packs a key & its index so that unsigned order is (key in the requested order, index).
+ */
+static inline uint64_t compositeKey(const int key, const uint32_t idx, const bool desc) {
+    uint32_t high = (uint32_t)key ^ 0x80000000u;
+    return (uint64_t)(desc ? ~high : high) << 32 | idx;
+}
+
+/**
+ * @brief Recovers the key from a composite key.
+ */
+static inline int compositeKeyValue(const uint64_t composite, const bool desc) {
+    uint32_t high = (uint32_t)(composite >> 32);
+    return (int)((desc ? ~high : high) ^ 0x80000000u);
+}
+
+/**
+ * @brief Builds & sorts the composite keys of keys[0..length).
+ *
+ * The keys are built in index order, so an LSD radix sort over the high word only is
+ * enough: it is stable & leaves equal keys in index order.
+ *
+ * @param arena Arena that the two buffers of @p length composite keys are allocated from.
+ *
+ * @return Sorted composite keys, in one of the buffers; null, if they could not be allocated.
+ */
+static uint64_t* sortedCompositeKeys(const int keys[], const int length, const bool desc, ScratchArena& arena) {
+    uint64_t* composite = arena.allocateArray<uint64_t>(length);
+    uint64_t* scratch = arena.allocateArray<uint64_t>(length);
+
+    if (!composite || !scratch) {
+        return nullptr;
+    }
+
+    uint32_t counts[KEY_PASSES][KEY_BUCKETS] = {};
+
+    for (int i = 0; i < length; i++) {
+        composite[i] = compositeKey(keys[i], i, desc);
+
+        uint32_t high = (uint32_t)(composite[i] >> 32);
+        for (int pass = 0; pass < KEY_PASSES; pass++) {
+            counts[pass][(high >> (pass*KEY_BITS)) & (KEY_BUCKETS-1)]++;
+        }
+    }
+
+    uint64_t* src = composite;
+    uint64_t* dst = scratch;
+
+    for (int pass = 0; pass < KEY_PASSES; pass++) {
+        int shift = 32 + pass*KEY_BITS;
+
+        // Every key has the same digit in this pass, so the scatter would not move anything.
+        if (counts[pass][(src[0] >> shift) & (KEY_BUCKETS-1)] == (uint32_t)length) {
+            continue;
+        }
+
+        uint32_t offsets[KEY_BUCKETS];
+        uint32_t sum = 0;
+
+        for (int b = 0; b < KEY_BUCKETS; b++) {
+            offsets[b] = sum;
+            sum += counts[pass][b];
+        }
+
+        for (int i = 0; i < length; i++) {
+            dst[offsets[(src[i] >> shift) & (KEY_BUCKETS-1)]++] = src[i];
+        }
+
+        std::swap(src, dst);
+    }
+
+    return src;
+}
+
+/**
+ * @brief Sorts the array in ascending order using a stable sort.
+ *
+ * Equal ints cannot be told apart, so this is radixSort, which is stable (LSD). Use the
+ * stableSort template to sort records, or argSort & sortByKey to carry data with the keys.
+ *
+ * @param arr Pointer to the array.
+ * @param length Number of elements in the array.
+ * @param desc If true, sorts the array in descending order; otherwise, sorts it in ascending order. (default=false)
+ *
+ * @note @p arr must be a non-null pointer, and @p length must be a non-negative integer.
+ */
+void stableSort(int arr[], const int length, const bool desc) {
+    if (!arr) {
+        return;
+    }
+    if (length <= 0) {
+        return;
+    }
+
+    radixSort(arr, length, desc);
+}
+
+/**
+ * @brief Writes the permutation that stably sorts the keys, without moving them.
+ *
+ * keys[indices[0]], keys[indices[1]], ... is sorted; equal keys appear in input order.
+ *
+ * @param keys Pointer to the keys.
+ * @param length Number of keys.
+ * @param indices Pointer to @p length integers that receive the permutation.
+ * @param desc If true, orders the keys descending; otherwise, ascending. (default=false)
+ *
+ * @return 0, if @p indices holds the permutation.
+ * @return -2, if @p keys or @p indices is null or if @p length is a non-positive integer.
+ * @return -4, if the 16 bytes per key of working memory could not be allocated.
+ *
+ * @code
+ * int keys[] = {30, 10, 20, 10};
+ * int indices[4];
+ *
+ * argSort(keys, 4, indices); // indices = {1, 3, 2, 0}
+ * argSort(keys, 4, indices, true); // indices = {0, 2, 1, 3}
+ * @endcode
+ */
+int argSort(const int keys[], const int length, int indices[], const bool desc) {
+    if (!keys || !indices) {
+        return -2;
+    }
+    if (length <= 0) {
+        return -2;
+    }
+
+    ScratchArena& arena = threadScratchArena();
+    ScratchScope scope(arena);
+
+    uint64_t* composite = sortedCompositeKeys(keys, length, desc, arena);
+    if (!composite) {
+        return -4;
+    }
+
+    for (int i = 0; i < length; i++) {
+        indices[i] = (int)(uint32_t)composite[i];
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Stably sorts the keys & applies the same permutation to a parallel payload array.
+ *
+ * @param keys Pointer to the keys.
+ * @param payload Pointer to the payload; payload[i] belongs to keys[i]. May not alias @p keys.
+ * @param length Number of keys & payload elements.
+ * @param desc If true, sorts the keys descending; otherwise, ascending. (default=false)
+ *
+ * @return 0, if both arrays are sorted.
+ * @return -2, if @p keys or @p payload is null, if they are the same array or if @p length is a non-positive integer.
+ * @return -4, if the working memory could not be allocated; neither array is changed.
+ *
+ * @code
+ * int ages[] = {31, 25, 31, 19};
+ * int ids[] = {100, 101, 102, 103};
+ *
+ * sortByKey(ages, ids, 4); // ages = {19, 25, 31, 31}, ids = {103, 101, 100, 102}
+ * @endcode
+ */
+int sortByKey(int keys[], int payload[], const int length, const bool desc) {
+    if (!keys || !payload || keys == payload) {
+        return -2;
+    }
+    if (length <= 0) {
+        return -2;
+    }
+
+    ScratchArena& arena = threadScratchArena();
+    ScratchScope scope(arena);
+
+    int* payload_copy = arena.allocateArray<int>(length);
+    uint64_t* composite = sortedCompositeKeys(keys, length, desc, arena);
+    if (!payload_copy || !composite) {
+        return -4;
+    }
+
+    std::memcpy(payload_copy, payload, (size_t)length * sizeof(int));
+
+    // The key is in the composite itself, so only the payload needs a gather.
+    for (int i = 0; i < length; i++) {
+        keys[i] = compositeKeyValue(composite[i], desc);
+        payload[i] = payload_copy[(uint32_t)composite[i]];
+    }
+
+    return 0;
+}
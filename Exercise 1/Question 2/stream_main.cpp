@@ -0,0 +1,184 @@
+/**
+ * @file stream_main.cpp
+ * @brief Program to summarize a never-ending stream of integers - Top-k, Quantiles, Minimum & Maximum.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "io.h"
+#include "stream_summary.h"
+
+using std::cerr;
+using std::endl;
+
+// ====== Stream Mode ======
+int runStream(int, char*[]);
+static bool parseQuantiles(const char*, std::vector<double>*);
+static void printSnapshot(const StreamSnapshot&, const std::vector<double>&);
+static int addBatch(const int[], const int, void*);
+
+static const char* const STREAM_OPTIONS[] = {"input", "top", "desc", "interval", "quantiles", "sketch-k", nullptr};
+
+// Quantiles reported unless --quantiles lists others.
+static const char* const DEFAULT_QUANTILES = "0.5,0.9,0.99";
+
+
+/*
+Usage:
+    stream --input=FILE [--top=K] [--desc] [--interval=SECONDS] [--quantiles=Q,...] [--sketch-k=K]
+           FILE: whitespace-separated integers, read as they arrive until end of file ("-" for stdin)
+*/
+int main(int argc, char* argv[]) {
+    return runStream(argc, argv);
+}
+
+/**
+ * @brief Reads integers until the end of the input, printing a summary every interval & a final one at the end.
+ *
+ * The main thread parses & adds batches; a reporter thread wakes every --interval seconds
+ * (default 1, 0 for the final summary only), takes a snapshot & prints it, so a slow
+ * reader of stdout never stalls ingestion. Memory stays bounded however long the input is:
+ * the read buffer, K top elements & about 3 * --sketch-k sketch items. Each summary is one
+ * line of key=value pairs on stdout: count, min, max, one pQ per quantile & the top-k,
+ * smallest first (largest first with --desc).
+ *
+ * @param argc, argv Arguments passed to main.
+ *
+ * @return 0, if the whole input was read; otherwise, 1 after printing an error to stderr.
+ *
+ * @code
+ * // tail -F latencies.log | ./stream --input=- --top=5 --desc --interval=10
+ * // count=1048576 min=3 max=91234 p50=412 p90=1873 p99=10022 top=91234,88120,70411,65530,61003
+ * @endcode
+ */
+int runStream(int argc, char* argv[]) {
+    const char* unknown = findUnknownOption(argc, argv, STREAM_OPTIONS);
+    const char* input = getOption(argc, argv, "input");
+    const char* top = getOption(argc, argv, "top");
+    const char* interval = getOption(argc, argv, "interval");
+    const char* quantile_list = getOption(argc, argv, "quantiles");
+    const char* sketch_k = getOption(argc, argv, "sketch-k");
+    const bool desc = hasFlag(argc, argv, "desc");
+
+    std::vector<double> quantiles;
+    const int k = top ? std::atoi(top) : 10;
+    const double interval_seconds = interval ? std::atof(interval) : 1.0;
+
+    if (unknown) {
+        cerr << "Error: Unknown option " << unknown << "." << endl;
+        return 1;
+    }
+    if (!input || k < 0 || interval_seconds < 0 || !parseQuantiles(quantile_list ? quantile_list : DEFAULT_QUANTILES, &quantiles)) {
+        cerr << "Usage: " << argv[0] << " --input=FILE [--top=K] [--desc] [--interval=SECONDS] [--quantiles=Q,...] [--sketch-k=K]" << endl;
+        cerr << "Q: ranks between 0 & 1, e.g. 0.5,0.9,0.99" << endl;
+        return 1;
+    }
+
+    StreamSummary summary(k, desc, sketch_k ? std::atoi(sketch_k) : QUANTILE_SKETCH_DEFAULT_K);
+
+    std::mutex reporter_mutex;
+    std::condition_variable reporter_cv;
+    bool done = false;
+
+    std::thread reporter([&]() {
+        if (interval_seconds == 0) {
+            return;
+        }
+
+        auto period = std::chrono::duration<double>(interval_seconds);
+        std::unique_lock<std::mutex> lock(reporter_mutex);
+
+        while (!reporter_cv.wait_for(lock, period, [&]() { return done; })) {
+            lock.unlock();
+            printSnapshot(summary.snapshot(), quantiles);
+            lock.lock();
+        }
+    });
+
+    int status = streamIntegerFile(input, addBatch, &summary);
+
+    {
+        std::lock_guard<std::mutex> lock(reporter_mutex);
+        done = true;
+    }
+    reporter_cv.notify_one();
+    reporter.join();
+
+    if (status == -5) {
+        cerr << "Error: " << input << " must hold only whitespace-separated integers." << endl;
+        return 1;
+    }
+    if (status != 0) {
+        cerr << "Error: Could not read integers from " << input << "." << endl;
+        return 1;
+    }
+
+    printSnapshot(summary.snapshot(), quantiles);
+    return 0;
+}
+
+/**
+ * @brief Adds a batch read by streamIntegerFile to the StreamSummary @p context.
+ */
+static int addBatch(const int batch[], const int length, void* context) {
+    static_cast<StreamSummary*>(context)->add(batch, length);
+    return 0;
+}
+
+/**
+ * @brief Parses a comma-separated list of ranks between 0 & 1.
+ *
+ * @return True, if every rank is valid & there is at least one; otherwise, false.
+ */
+static bool parseQuantiles(const char* text, std::vector<double>* quantiles) {
+    while (*text) {
+        char* end;
+        double q = std::strtod(text, &end);
+
+        if (end == text || q < 0 || q > 1 || (*end != ',' && *end != '\0')) {
+            return false;
+        }
+
+        quantiles->push_back(q);
+        text = *end == ',' ? end + 1 : end;
+    }
+
+    return !quantiles->empty();
+}
+
+/**
+ * @brief Prints a snapshot as one line of key=value pairs to stdout & flushes it, for logs & pipes.
+ *
+ * Prints only the count while the stream is still empty.
+ */
+static void printSnapshot(const StreamSnapshot& snapshot, const std::vector<double>& quantiles) {
+    if (snapshot.count == 0) {
+        std::printf("count=0\n");
+        std::fflush(stdout);
+        return;
+    }
+
+    std::vector<int> values(quantiles.size());
+    snapshot.sketch.quantiles(quantiles.data(), (int)quantiles.size(), values.data());
+
+    std::printf("count=%lld min=%d max=%d", snapshot.count, snapshot.min, snapshot.max);
+    for (size_t i = 0; i < quantiles.size(); i++) {
+        std::printf(" p%g=%d", quantiles[i] * 100, values[i]);
+    }
+
+    std::printf(" top=");
+    for (size_t i = 0; i < snapshot.top.size(); i++) {
+        std::printf(i == 0 ? "%d" : ",%d", snapshot.top[i]);
+    }
+    std::printf("\n");
+    std::fflush(stdout);
+}
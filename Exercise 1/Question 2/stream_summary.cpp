@@ -0,0 +1,64 @@
+/**
+ * @file stream_summary.cpp
+ * @brief Streaming summary - Exact top-k & approximate quantiles of an unbounded stream, readable while it is fed.
+ *
+ * Provides function definitions for StreamSummary.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include "stream_summary.h"
+
+
+/**
+ * @brief Creates an empty summary.
+ *
+ * @param k Number of elements the top-k keeps.
+ * @param desc If true, keeps the k largest elements; otherwise, the k smallest. (default=false)
+ * @param sketch_k Accuracy parameter of the quantile sketch. (default=200)
+ *
+ * @code
+ * StreamSummary summary(10, true);
+ *
+ * streamIntegerFile("-", [](const int batch[], const int length, void* context) {
+ *     static_cast<StreamSummary*>(context)->add(batch, length);
+ *     return 0;
+ * }, &summary);
+ * @endcode
+ */
+StreamSummary::StreamSummary(size_t k, bool desc, int sketch_k) : top_(k, StreamOrder{desc}), sketch_(sketch_k) {}
+
+/**
+ * @brief Adds a batch of elements of the stream. O(n log k) for the top-k; amortized O(n log k) for the sketch.
+ *
+ * @param values Pointer to the elements.
+ * @param length Number of elements. Nothing happens if it is not positive.
+ */
+void StreamSummary::add(const int values[], const int length) {
+    if (!values || length <= 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    sketch_.update(values, length);
+    for (int i = 0; i < length; i++) {
+        top_.push(values[i]);
+    }
+}
+
+/**
+ * @brief Returns the state of the summary after the batches added so far. Safe to call while another thread adds.
+ *
+ * Holds the lock only to copy the top-k heap & the sketch; the top-k is sorted afterwards.
+ */
+StreamSnapshot StreamSummary::snapshot() const {
+    std::unique_lock<std::mutex> lock(mutex_);
+    TopK<int, StreamOrder> top = top_;
+    StreamSnapshot snapshot = {sketch_.count(), sketch_.min(), sketch_.max(), {}, sketch_};
+    lock.unlock();
+
+    snapshot.top = top.sorted();
+    return snapshot;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file stream_summary.h
+ * @brief Streaming summary - Exact top-k & approximate quantiles of an unbounded stream, readable while it is fed.
+ *
+ * A StreamSummary combines a TopK heap & a QuantileSketch behind one mutex. The thread
+ * that ingests the stream adds whole batches; any other thread may take a snapshot at
+ * any time, which copies the few kilobytes of state under the lock & does the sorting
+ * outside it, so reporting never holds up ingestion for more than one batch.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <vector>
+#include "quantile_sketch.h"
+#include "top_k.h"
+
+/**
+ * @brief Comparator chosen at run time: ascending, or descending if desc is set.
+ */
+struct StreamOrder {
+    bool desc;
+
+    bool operator()(const int a, const int b) const { return desc ? a > b : a < b; }
+};
+
+/**
+ * @brief The state of a StreamSummary at one point of the stream.
+ */
+struct StreamSnapshot {
+    long long count;
+    int min;
+    int max;
+    std::vector<int> top;   // The k smallest (largest, if desc) elements so far, in sort order.
+    QuantileSketch sketch;  // Quantiles of every element so far.
+};
+
+class StreamSummary {
+public:
+    explicit StreamSummary(size_t k, bool desc = false, int sketch_k = QUANTILE_SKETCH_DEFAULT_K);
+
+    StreamSummary(const StreamSummary&) = delete;
+    StreamSummary& operator=(const StreamSummary&) = delete;
+
+    void add(const int values[], int length);
+    StreamSnapshot snapshot() const;
+
+private:
+    mutable std::mutex mutex_;
+    TopK<int, StreamOrder> top_;
+    QuantileSketch sketch_;
+};
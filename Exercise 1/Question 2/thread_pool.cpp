@@ -0,0 +1,244 @@
+/**
+ * @file thread_pool.cpp
+ * @brief Work-stealing thread pool & task groups for fork-join parallelism.
+ *
+ * Provides function definitions for ThreadPool & TaskGroup.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#include <algorithm>
+#include <map>
+#include "thread_pool.h"
+
+// Pool that owns the calling thread & its deque index; (nullptr, 0) outside any pool.
+static thread_local const ThreadPool* current_pool = nullptr;
+static thread_local int current_queue_idx = 0;
+
+
+/**
+ * @brief Starts a pool with @p num_threads worker threads.
+ *
+ * @param num_threads Number of worker threads. If non-positive, uses the number of hardware threads. (default=0)
+ *
+ * @note The thread that waits on a TaskGroup also runs tasks, so @p num_threads - 1
+ * workers plus the caller keep @p num_threads cores busy.
+ *
+ * @code
+ * ThreadPool pool(8);
+ * TaskGroup group(pool);
+ * group.run([] { work(); });
+ * group.wait();
+ * @endcode
+ */
+ThreadPool::ThreadPool(int num_threads) : stop_(false), queued_(0) {
+    if (num_threads <= 0) {
+        num_threads = (int)std::thread::hardware_concurrency();
+    }
+    if (num_threads <= 0) {
+        num_threads = 1;
+    }
+
+    // Deque 0 belongs to threads outside the pool; deques 1..n-1 to the workers.
+    for (int i = 0; i < num_threads; i++) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+    for (int i = 1; i < num_threads; i++) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+/**
+ * @brief Stops & joins every worker thread. Tasks still queued are discarded.
+ */
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+        stop_ = true;
+    }
+    sleep_cv_.notify_all();
+
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+/**
+ * @brief Returns the total number of threads that run tasks, counting the caller.
+ */
+int ThreadPool::size() const {
+    return (int)queues_.size();
+}
+
+/**
+ * @brief Returns the deque owned by the calling thread.
+ */
+int ThreadPool::currentQueueIdx() const {
+    return current_pool == this ? current_queue_idx : 0;
+}
+
+/**
+ * @brief Queues a task on the calling thread's deque & wakes a sleeping worker.
+ *
+ * @param task Callable to run on some pool thread.
+ */
+void ThreadPool::submit(std::function<void()> task) {
+    WorkQueue& queue = *queues_[currentQueueIdx()];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+    }
+    queued_++;
+
+    {
+        // Taking the lock orders this wake-up after a worker's check of queued_.
+        std::lock_guard<std::mutex> lock(sleep_mutex_);
+    }
+    sleep_cv_.notify_one();
+}
+
+/**
+ * @brief Pops the newest task from deque @p queue_idx.
+ *
+ * @return True, if a task was moved into @p task; otherwise, false.
+ */
+bool ThreadPool::popLocal(int queue_idx, std::function<void()>& task) {
+    WorkQueue& queue = *queues_[queue_idx];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (queue.tasks.empty()) {
+        return false;
+    }
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+/**
+ * @brief Steals the oldest task from any deque other than @p thief_idx.
+ *
+ * @return True, if a task was moved into @p task; otherwise, false.
+ */
+bool ThreadPool::steal(int thief_idx, std::function<void()>& task) {
+    int n = size();
+
+    for (int offset = 1; offset < n; offset++) {
+        WorkQueue& queue = *queues_[(thief_idx + offset) % n];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (!queue.tasks.empty()) {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * @brief Runs one queued task on the calling thread, preferring its own deque.
+ *
+ * @return True, if a task was run; false, if every deque was empty.
+ */
+bool ThreadPool::runPendingTask() {
+    int queue_idx = currentQueueIdx();
+    std::function<void()> task;
+
+    if (!popLocal(queue_idx, task) && !steal(queue_idx, task)) {
+        return false;
+    }
+
+    queued_--;
+    task();
+    return true;
+}
+
+/**
+ * @brief Body of worker thread @p worker_idx: runs tasks until the pool is destroyed.
+ */
+void ThreadPool::workerLoop(int worker_idx) {
+    current_pool = this;
+    current_queue_idx = worker_idx;
+
+    while (!stop_) {
+        if (runPendingTask()) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleep_mutex_);
+        sleep_cv_.wait(lock, [this] { return stop_ || queued_ > 0; });
+    }
+}
+
+/**
+ * @brief Returns the process-wide pool with @p num_threads threads, starting it on first use.
+ *
+ * Sorts take their pool from here instead of constructing one per call, so the threads
+ * are spawned once per thread count & their scratch arenas stay mapped between sorts.
+ * Threads outside the pool may share it: their tasks all go to deque 0.
+ *
+ * @param num_threads Number of threads. If non-positive, uses the number of hardware threads. (default=0)
+ *
+ * @code
+ * TaskGroup group(sharedThreadPool(8));
+ * group.run([] { work(); });
+ * group.wait();
+ * @endcode
+ */
+ThreadPool& sharedThreadPool(int num_threads) {
+    static std::mutex mutex;
+    static std::map<int, std::unique_ptr<ThreadPool>> pools;
+
+    if (num_threads <= 0) {
+        num_threads = std::max(1, (int)std::thread::hardware_concurrency());
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    std::unique_ptr<ThreadPool>& pool = pools[num_threads];
+    if (!pool) {
+        pool = std::make_unique<ThreadPool>(num_threads);
+    }
+
+    return *pool;
+}
+
+/**
+ * @brief Creates an empty group of tasks that run on @p pool.
+ */
+TaskGroup::TaskGroup(ThreadPool& pool) : pool_(pool), pending_(0) {
+}
+
+/**
+ * @brief Waits for every task of the group, so no task outlives the state it captured.
+ */
+TaskGroup::~TaskGroup() {
+    wait();
+}
+
+/**
+ * @brief Queues @p task on the pool as part of this group.
+ */
+void TaskGroup::run(std::function<void()> task) {
+    pending_++;
+    pool_.submit([this, task = std::move(task)] {
+        task();
+        pending_--;
+    });
+}
+
+/**
+ * @brief Blocks until every task of the group has finished.
+ *
+ * @note The waiting thread runs queued tasks (its own first, then stolen ones)
+ * instead of sleeping, so nested fork-join never deadlocks the pool.
+ */
+void TaskGroup::wait() {
+    while (pending_ > 0) {
+        if (!pool_.runPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+}
@@ -0,0 +1,74 @@
+/**
+ * @file thread_pool.h
+ * @brief Work-stealing thread pool & task groups for fork-join parallelism.
+ *
+ * Every thread owns a task deque. A thread pushes & pops its own tasks at the back
+ * (newest first, which keeps recursive splits cache-warm) and, when its deque is
+ * empty, steals from the front of another thread's deque (oldest first, which
+ * hands out the largest pieces of work). Threads outside the pool share deque 0.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class ThreadPool {
+public:
+    explicit ThreadPool(int num_threads = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(std::function<void()> task);
+    bool runPendingTask();
+    int size() const;
+
+private:
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(int worker_idx);
+    bool popLocal(int queue_idx, std::function<void()>& task);
+    bool steal(int thief_idx, std::function<void()>& task);
+    int currentQueueIdx() const;
+
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::vector<std::thread> workers_;
+
+    std::atomic<bool> stop_;
+    std::atomic<int> queued_;
+
+    std::mutex sleep_mutex_;
+    std::condition_variable sleep_cv_;
+};
+
+ThreadPool& sharedThreadPool(int num_threads = 0);
+
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool& pool);
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    void run(std::function<void()> task);
+    void wait();
+
+private:
+    ThreadPool& pool_;
+    std::atomic<int> pending_;
+};
@@ -0,0 +1,143 @@
+/**
+ * @file top_k.h
+ * @brief Streaming top-k - The k first elements, in sort order, of a stream too long to keep.
+ *
+ * TopK keeps the k best elements seen so far in a binary heap whose top is the worst of
+ * them, so each new element costs one comparison when it does not qualify & O(log k) when
+ * it does: O(n log k) time & O(k) memory for a stream of n elements. The comparator follows
+ * the convention of sort_templates.h: std::less<> keeps the k smallest, std::greater<> the k largest.
+ *
+ * @author Abdullah Sheriff
+ * @date Februrary 8th, 2025
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+#include "sort_templates.h"
+
+template <typename T, typename Compare = std::less<>>
+class TopK {
+public:
+    explicit TopK(size_t k, Compare comp = Compare());
+
+    void push(const T& value);
+    void clear();
+
+    size_t size() const;
+    size_t capacity() const;
+    bool full() const;
+    const T& threshold() const;
+    std::vector<T> sorted() const;
+
+private:
+    std::vector<T> heap_;
+    size_t k_;
+    Compare comp_;
+};
+
+
+/**
+ * @brief Creates an empty top-k of capacity @p k.
+ *
+ * @param k Number of elements to keep. A capacity of 0 keeps nothing.
+ * @param comp Strict weak ordering; the k elements a sort by @p comp would put first are kept. (default=std::less<>)
+ *
+ * @code
+ * TopK<int, std::greater<>> largest(3);
+ *
+ * for (int x : {5, 1, 9, 7, 3}) {
+ *     largest.push(x);
+ * }
+ * largest.sorted(); // {9, 7, 5}
+ * @endcode
+ */
+template <typename T, typename Compare>
+TopK<T, Compare>::TopK(size_t k, Compare comp) : k_(k), comp_(comp) {
+    heap_.reserve(k);
+}
+
+/**
+ * @brief Offers an element to the top-k, evicting the current threshold if @p value beats it.
+ *
+ * Ties with the threshold are not kept, so the first of equal elements win.
+ */
+template <typename T, typename Compare>
+void TopK<T, Compare>::push(const T& value) {
+    if (heap_.size() < k_) {
+        heap_.push_back(value);
+
+        // Sift up: the worst kept element stays at the top.
+        size_t hole = heap_.size() - 1;
+        while (hole > 0 && comp_(heap_[(hole-1)/2], heap_[hole])) {
+            std::swap(heap_[(hole-1)/2], heap_[hole]);
+            hole = (hole-1)/2;
+        }
+        return;
+    }
+
+    if (k_ > 0 && comp_(value, heap_[0])) {
+        heap_[0] = value;
+        heapSiftDown(heap_.begin(), 0, (std::ptrdiff_t)heap_.size(), comp_);
+    }
+}
+
+/**
+ * @brief Empties the top-k, keeping its capacity & memory.
+ */
+template <typename T, typename Compare>
+void TopK<T, Compare>::clear() {
+    heap_.clear();
+}
+
+/**
+ * @brief Returns the number of elements kept, at most capacity().
+ */
+template <typename T, typename Compare>
+size_t TopK<T, Compare>::size() const {
+    return heap_.size();
+}
+
+/**
+ * @brief Returns k.
+ */
+template <typename T, typename Compare>
+size_t TopK<T, Compare>::capacity() const {
+    return k_;
+}
+
+/**
+ * @brief Returns true once k elements are kept; from then on, only elements that beat threshold() get in.
+ */
+template <typename T, typename Compare>
+bool TopK<T, Compare>::full() const {
+    return k_ > 0 && heap_.size() == k_;
+}
+
+/**
+ * @brief Returns the worst element kept, which every new element must beat once the top-k is full.
+ *
+ * @note The top-k must not be empty.
+ */
+template <typename T, typename Compare>
+const T& TopK<T, Compare>::threshold() const {
+    return heap_[0];
+}
+
+/**
+ * @brief Returns the kept elements, in the order a sort by the comparator would put them.
+ */
+template <typename T, typename Compare>
+std::vector<T> TopK<T, Compare>::sorted() const {
+    std::vector<T> result(heap_);
+
+    // The heap is ordered by comp_ with the worst on top, which is exactly what heap sort finishes.
+    for (auto end = (std::ptrdiff_t)result.size() - 1; end > 0; end--) {
+        std::swap(result[0], result[end]);
+        heapSiftDown(result.begin(), 0, end, comp_);
+    }
+
+    return result;
+}